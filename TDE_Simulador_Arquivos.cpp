@@ -5,6 +5,33 @@
 #include <algorithm>
 #include <iomanip>
 #include <random>
+#include <list>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <climits>
+#include <cmath>
+#include <chrono>
+#include <queue>
+#include <deque>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SIMULADOR_COM_MMAP 1
+#else
+#define SIMULADOR_COM_MMAP 0
+#endif
 using namespace std;
 
 struct File;
@@ -12,6 +39,15 @@ struct File;
 constexpr int BLOCO_LIVRE = -1;
 constexpr int FIM_CADEIA = -2;
 constexpr int TAMANHO_BLOCO = 8;
+constexpr int MAX_ENTRADAS_INDICE = 8; // endereços que cabem no bloco índice
+constexpr int MAX_EXTENTS = 4;         // extents (trechos contíguos) por arquivo
+
+// métodos de alocação (mesma numeração do menu inicial)
+constexpr int METODO_CONTIGUO = 1;
+constexpr int METODO_ENCADEADO = 2;
+constexpr int METODO_INDEXADO = 3;
+constexpr int METODO_EXTENTS = 4;
+constexpr int METODO_MISTO = 5;
 
 int computeFragmentation(int blocks, int fileBytes) {
     return blocks * TAMANHO_BLOCO - fileBytes;
@@ -39,16 +75,116 @@ void printFreeBlock(size_t blockIdx) {
     cout << "[" << blockIdx << "] ░";
 }
 
+// ---------------- rastreamento (Chrome trace-event JSON) ----------------
+// cada EscopoRastro vira um evento completo ("ph":"X") num buffer circular sem travas: quem registra
+// reserva a posição com fetch_add e publica o evento pelo número de sequência da posição, e o gravador
+// descarta posições que estavam sendo reescritas. Desativado, o escopo custa uma leitura relaxada
+constexpr uint64_t CAPACIDADE_RASTRO = 1 << 16; // eventos mais recentes mantidos (potência de 2)
+
+struct PosicaoRastro {
+    atomic<uint64_t> sequencia{0}; // índice do evento + 1 quando publicado; 0 durante a escrita
+    atomic<const char*> nome{nullptr};
+    atomic<long long> inicio{0};   // ns desde a ativação
+    atomic<long long> duracao{0};
+    atomic<int> thread{0};
+};
+
+struct Rastreamento {
+    atomic<bool> ativo{false};
+    atomic<uint64_t> proximo{0};
+    atomic<int> proximaThread{0};
+    chrono::steady_clock::time_point origem;
+    PosicaoRastro posicoes[CAPACIDADE_RASTRO];
+};
+
+Rastreamento rastreamento;
+
+long long instanteRastroNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - rastreamento.origem).count();
+}
+
+int threadDoRastro() {
+    thread_local int id = rastreamento.proximaThread.fetch_add(1, memory_order_relaxed) + 1;
+    return id;
+}
+
+void registrarEventoRastro(const char* nome, long long inicio, long long duracao) {
+    uint64_t indice = rastreamento.proximo.fetch_add(1, memory_order_relaxed);
+    PosicaoRastro& posicao = rastreamento.posicoes[indice & (CAPACIDADE_RASTRO - 1)];
+    posicao.sequencia.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    posicao.nome.store(nome, memory_order_relaxed);
+    posicao.inicio.store(inicio, memory_order_relaxed);
+    posicao.duracao.store(duracao, memory_order_relaxed);
+    posicao.thread.store(threadDoRastro(), memory_order_relaxed);
+    posicao.sequencia.store(indice + 1, memory_order_release);
+}
+
+// mede o bloco em que é declarado; o nome precisa ser um literal (só o ponteiro é guardado)
+struct EscopoRastro {
+    const char* nome;
+    long long inicio = 0;
+    explicit EscopoRastro(const char* nomeEscopo)
+        : nome(rastreamento.ativo.load(memory_order_relaxed) ? nomeEscopo : nullptr) {
+        if (nome) inicio = instanteRastroNs();
+    }
+    ~EscopoRastro() {
+        if (nome) registrarEventoRastro(nome, inicio, instanteRastroNs() - inicio);
+    }
+    EscopoRastro(const EscopoRastro&) = delete;
+    EscopoRastro& operator=(const EscopoRastro&) = delete;
+};
+
+void ativarRastreamento() {
+    rastreamento.origem = chrono::steady_clock::now();
+    for (PosicaoRastro& posicao : rastreamento.posicoes) posicao.sequencia.store(0, memory_order_relaxed);
+    rastreamento.proximo.store(0, memory_order_relaxed);
+    rastreamento.ativo.store(true, memory_order_release);
+}
+
+// grava os eventos do buffer no formato aceito pelo chrome://tracing e pelo Perfetto; devolve quantos
+// foram gravados ou -1 se o arquivo não pôde ser aberto
+long long gravarRastro(const string& caminho) {
+    ofstream saida(caminho, ios::trunc);
+    if (!saida) return -1;
+    uint64_t fim = rastreamento.proximo.load(memory_order_acquire);
+    uint64_t inicio = fim > CAPACIDADE_RASTRO ? fim - CAPACIDADE_RASTRO : 0;
+    long long gravados = 0;
+    saida << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    saida << fixed << setprecision(3);
+    for (uint64_t indice = inicio; indice < fim; ++indice) {
+        const PosicaoRastro& posicao = rastreamento.posicoes[indice & (CAPACIDADE_RASTRO - 1)];
+        if (posicao.sequencia.load(memory_order_acquire) != indice + 1) continue;
+        const char* nome = posicao.nome.load(memory_order_relaxed);
+        long long comeco = posicao.inicio.load(memory_order_relaxed);
+        long long duracao = posicao.duracao.load(memory_order_relaxed);
+        int thread = posicao.thread.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (posicao.sequencia.load(memory_order_relaxed) != indice + 1) continue; // reescrito durante a cópia
+        saida << (gravados++ ? ",\n" : "\n") << "{\"name\":\"" << nome << "\",\"cat\":\"simulador\",\"ph\":\"X\",\"ts\":"
+              << comeco / 1000.0 << ",\"dur\":" << duracao / 1000.0 << ",\"pid\":1,\"tid\":" << thread << "}";
+    }
+    saida << "\n]}\n";
+    return saida ? gravados : -1;
+}
+
 vector<int> collectFreeBlocks(const vector<int>& disk) {
+    EscopoRastro rastro("collectFreeBlocks");
     vector<int> freeBlocks;
     freeBlocks.reserve(disk.size());
     for (size_t i = 0; i < disk.size(); ++i) if (disk[i] == BLOCO_LIVRE) freeBlocks.push_back((int)i);
     return freeBlocks;
 }
 
+// gerador por thread: instâncias paralelas do simulador fixam a própria semente sem interferir umas nas outras
+mt19937& geradorEmbaralhamento() {
+    thread_local mt19937 gerador(random_device{}());
+    return gerador;
+}
+
 void shuffleInPlace(vector<int>& v) {
-    random_device rd; mt19937 g(rd());
-    shuffle(v.begin(), v.end(), g);
+    EscopoRastro rastro("shuffleInPlace");
+    shuffle(v.begin(), v.end(), geradorEmbaralhamento());
 }
 
 pair<int,int> consumeLastBlockSpace(int currentBytes, int blockSize, int extraBytes) {
@@ -64,29 +200,908 @@ void printFreeBytesFooter(int totalBytes) {
     cout << "Total de bytes livres no disco: " << totalBytes << " bytes" << "\n";
 }
 
+// varint = LEB128 sem sinal; inteiros com sinal passam por zigzag (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+template <typename Buffer>
+void escreverVarint(Buffer& buffer, uint64_t valor) {
+    while (valor >= 0x80) {
+        buffer.push_back(static_cast<char>((valor & 0x7F) | 0x80));
+        valor >>= 7;
+    }
+    buffer.push_back(static_cast<char>(valor));
+}
+
+uint64_t lerVarint(const char*& p) {
+    uint64_t valor = 0;
+    for (int deslocamento = 0;; deslocamento += 7) {
+        unsigned char byte = static_cast<unsigned char>(*p++);
+        valor |= static_cast<uint64_t>(byte & 0x7F) << deslocamento;
+        if (byte < 0x80) return valor;
+    }
+}
+
+uint64_t zigzag(int64_t valor) {
+    return (static_cast<uint64_t>(valor) << 1) ^ static_cast<uint64_t>(valor >> 63);
+}
+
+int64_t desfazerZigzag(uint64_t valor) {
+    return static_cast<int64_t>(valor >> 1) ^ -static_cast<int64_t>(valor & 1);
+}
+
+// bytes que o malloc reserva para um pedido (estimativa do glibc: cabeçalho de 8 bytes, múltiplos de 16, mínimo 32)
+size_t bytesNoHeap(size_t pedido) {
+    return pedido == 0 ? 0 : max<size_t>(32, (pedido + 8 + 15) / 16 * 16);
+}
+
+// lista de blocos da encadeada e da indexada, guardada como trechos de blocos consecutivos: cada trecho
+// vira um varint com a diferença em zigzag para o último bloco do trecho anterior e, no bit mais baixo,
+// se o trecho tem mais de um bloco (então segue outro varint com tamanho - 2). O último trecho fica
+// aberto fora do buffer, então push_back só estende um contador ou fecha o trecho. Um arquivo sequencial
+// cabe em poucos bytes e um espalhado custa 1 ou 2 bytes por bloco; listas curtas ficam dentro da própria
+// string (sem alocação). Não há acesso por posição: percorre-se com o iterador ou com decodificar(), que
+// expande cada trecho num laço simples que o compilador vetoriza
+struct ListaBlocos {
+    string codificados;         // trechos fechados
+    int fimFechado = 0;         // último bloco do último trecho fechado (base da próxima diferença)
+    int inicioAberto = 0;
+    int tamanhoAberto = 0;
+    int quantidade = 0;
+
+    struct iterator {
+        using iterator_category = forward_iterator_tag;
+        using value_type = int;
+        using difference_type = ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        const ListaBlocos* lista = nullptr;
+        const char* p = nullptr;
+        int base = 0;
+        int atual = 0;
+        int restantes = 0;      // blocos do trecho atual depois de "atual"
+        int posicao = 0;
+
+        void carregarTrecho() {
+            if (p < lista->codificados.data() + lista->codificados.size()) {
+                uint64_t cabecalho = lerVarint(p);
+                atual = base + static_cast<int>(desfazerZigzag(cabecalho >> 1));
+                restantes = (cabecalho & 1) ? static_cast<int>(lerVarint(p)) + 1 : 0;
+                base = atual + restantes;
+            } else {
+                atual = lista->inicioAberto;
+                restantes = lista->tamanhoAberto - 1;
+            }
+        }
+        int operator*() const { return atual; }
+        iterator& operator++() {
+            if (++posicao == lista->quantidade) return *this;
+            if (restantes > 0) {
+                ++atual;
+                --restantes;
+            } else {
+                carregarTrecho();
+            }
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator anterior = *this;
+            ++*this;
+            return anterior;
+        }
+        bool operator==(const iterator& outro) const { return posicao == outro.posicao; }
+        bool operator!=(const iterator& outro) const { return posicao != outro.posicao; }
+    };
+    using const_iterator = iterator;
+
+    iterator begin() const {
+        iterator it;
+        it.lista = this;
+        it.p = codificados.data();
+        if (quantidade > 0) it.carregarTrecho();
+        return it;
+    }
+    iterator end() const {
+        iterator it;
+        it.lista = this;
+        it.posicao = quantidade;
+        return it;
+    }
+
+    size_t size() const { return static_cast<size_t>(quantidade); }
+    bool empty() const { return quantidade == 0; }
+    int front() const { return *begin(); }
+    int back() const { return inicioAberto + tamanhoAberto - 1; }
+
+    void push_back(int bloco) {
+        if (tamanhoAberto > 0 && bloco == inicioAberto + tamanhoAberto) {
+            ++tamanhoAberto;
+        } else {
+            if (tamanhoAberto > 0) {
+                uint64_t diferenca = zigzag(static_cast<int64_t>(inicioAberto) - fimFechado);
+                escreverVarint(codificados, diferenca << 1 | (tamanhoAberto > 1));
+                if (tamanhoAberto > 1) escreverVarint(codificados, static_cast<uint64_t>(tamanhoAberto - 2));
+                fimFechado = inicioAberto + tamanhoAberto - 1;
+            }
+            inicioAberto = bloco;
+            tamanhoAberto = 1;
+        }
+        ++quantidade;
+    }
+
+    void clear() { *this = ListaBlocos(); }
+
+    // substitui a lista inteira (criação, leitura da imagem): o tamanho é final, então devolve a folga do buffer
+    template <typename It>
+    void assign(It primeiro, It ultimo) {
+        clear();
+        append(primeiro, ultimo);
+        codificados.shrink_to_fit();
+    }
+
+    // acréscimo em lote (extensões): mantém a folga para o próximo crescimento
+    template <typename It>
+    void append(It primeiro, It ultimo) {
+        for (; primeiro != ultimo; ++primeiro) push_back(*primeiro);
+    }
+
+    // chama funcao(inicio, tamanho) para cada trecho, na ordem lógica, sem expandir os blocos
+    template <typename Funcao>
+    void paraCadaTrecho(Funcao&& funcao) const {
+        const char* p = codificados.data();
+        const char* fim = p + codificados.size();
+        int base = 0;
+        while (p < fim) {
+            uint64_t cabecalho = lerVarint(p);
+            int inicio = base + static_cast<int>(desfazerZigzag(cabecalho >> 1));
+            int tamanho = (cabecalho & 1) ? static_cast<int>(lerVarint(p)) + 2 : 1;
+            funcao(inicio, tamanho);
+            base = inicio + tamanho - 1;
+        }
+        if (tamanhoAberto > 0) funcao(inicioAberto, tamanhoAberto);
+    }
+
+    // expande a lista inteira em "saida" (quantidade posições)
+    void decodificar(int* saida) const {
+        paraCadaTrecho([&saida](int inicio, int tamanho) {
+            for (int k = 0; k < tamanho; ++k) saida[k] = inicio + k;
+            saida += tamanho;
+        });
+    }
+
+    vector<int> paraVetor() const {
+        vector<int> blocos(size());
+        decodificar(blocos.data());
+        return blocos;
+    }
+
+    // a codificação é canônica (trechos sempre maximais), então comparar os bytes basta
+    bool operator==(const ListaBlocos& outra) const {
+        return quantidade == outra.quantidade && inicioAberto == outra.inicioAberto &&
+               tamanhoAberto == outra.tamanhoAberto && codificados == outra.codificados;
+    }
+
+    size_t bytesUsados() const {
+        const char* dados = codificados.data();
+        bool naPropriaString = dados >= reinterpret_cast<const char*>(this) && dados < reinterpret_cast<const char*>(this + 1);
+        return sizeof(ListaBlocos) + (naPropriaString ? 0 : bytesNoHeap(codificados.capacity() + 1));
+    }
+};
+
+void printListaBlocos(const ListaBlocos& lista, const char* separador) {
+    bool primeiro = true;
+    for (int bloco : lista) {
+        cout << (primeiro ? "" : separador) << bloco;
+        primeiro = false;
+    }
+}
+
+// confere a ida e volta da codificação em casos de borda: diferenças negativas, trechos de um bloco,
+// saltos grandes, trecho aberto no fim e reuso depois de clear(). Usada pelo fsck
+bool verificarCodificacaoListas() {
+    const vector<vector<int>> casos = {
+        {},
+        {7},
+        {5, 3, 1},                          // só trechos de 1 com diferença negativa
+        {10, 11, 12, 2, 3, 100, 0},         // trechos de vários tamanhos, último aberto de 1 bloco
+        {40, 41, 42, 43, 0, 1, 2},          // volta ao início e termina num trecho aberto longo
+        {1000000, 0, 1000001, 64, 63, 62},  // saltos de vários bytes nos dois sentidos
+        {3, 4, 2, 5, 6, 7, 8, 1},
+    };
+    for (const vector<int>& blocos : casos) {
+        ListaBlocos lista;
+        for (int bloco : blocos) lista.push_back(bloco);
+
+        vector<int> percorridos(lista.begin(), lista.end());
+        if (lista.size() != blocos.size() || lista.paraVetor() != blocos || percorridos != blocos) return false;
+        if (!blocos.empty() && (lista.front() != blocos.front() || lista.back() != blocos.back())) return false;
+
+        // trechos maximais que somam a lista
+        int total = 0, fimAnterior = INT_MIN;
+        bool maximais = true;
+        lista.paraCadaTrecho([&](int inicio, int tamanho) {
+            if (tamanho < 1 || (fimAnterior != INT_MIN && inicio == fimAnterior + 1)) maximais = false;
+            total += tamanho;
+            fimAnterior = inicio + tamanho - 1;
+        });
+        if (!maximais || total != static_cast<int>(blocos.size())) return false;
+
+        // assign, append em duas partes e reuso depois de clear() chegam à mesma codificação
+        ListaBlocos emLote, emPartes, reusada;
+        emLote.assign(blocos.begin(), blocos.end());
+        size_t meio = blocos.size() / 2;
+        emPartes.append(blocos.begin(), blocos.begin() + meio);
+        emPartes.append(blocos.begin() + meio, blocos.end());
+        reusada.assign(casos.back().begin(), casos.back().end());
+        reusada.clear();
+        reusada.append(blocos.begin(), blocos.end());
+        if (!(emLote == lista) || !(emPartes == lista) || !(reusada == lista)) return false;
+    }
+    return true;
+}
+
 struct File {
     int indexBlock = -1;
     int startBlock = -1;
-    vector<int> dataBlocks;
+    ListaBlocos dataBlocks;   // encadeada e indexada, na ordem lógica
     int size = 0;            // em blocos
     int sizeBytes = 0;       // tamanho real em bytes
     string name;
     string color;
     int fragmentacao = 0;
+    int metodo = METODO_CONTIGUO;
+    vector<pair<int,int>> extents; // (bloco inicial, tamanho) de cada extent
+};
+
+// map que associa cada arquivo a uma tuple (startBlock, size) representando a tabela de diretório
+unordered_map<string, tuple<int, int>> tabelaDiretorio;
+
+// buffer sujo de um arquivo na alocação atrasada
+struct BufferSujo {
+    int metodo = METODO_CONTIGUO;
+    int bytes = 0;       // bytes ainda sem blocos no disco
+    bool novo = false;   // arquivo criado no buffer, ainda sem nenhum bloco
+};
+
+struct AlocacaoAtrasada {
+    bool ativa = false;
+    int operacoesPorTick = 5;          // o temporizador descarrega os buffers a cada N operações do menu
+    int limiteBytesSujos = 64;         // pressão de memória: total de bytes sujos que força o flush
+    int operacoesDesdeFlush = 0;
+    int operacoesAdiadas = 0;          // criações/extensões que chamariam o alocador imediatamente
+    int chamadasAlocador = 0;          // chamadas realmente feitas ao alocador nos flushes
+    unordered_map<string, BufferSujo> buffers;
+};
+
+AlocacaoAtrasada alocacaoAtrasada;
+
+int totalBytesSujos(const AlocacaoAtrasada& atrasada) {
+    int total = 0;
+    for (const auto& [nome, buffer] : atrasada.buffers) total += buffer.bytes;
+    return total;
+}
+
+// resultado das rotinas de alocação sem interação (as versões interativas exibem a mensagem)
+enum ResultadoAlocacao {
+    ALOCACAO_OK,
+    ERRO_ESPACO_INSUFICIENTE,
+    ERRO_SEM_ESPACO_CONTIGUO,
+    ERRO_INDICE_CHEIO,
+    ERRO_LIMITE_EXTENTS,
+    ERRO_ARQUIVO_EXISTENTE,
+    ERRO_ARQUIVO_INEXISTENTE
+};
+
+// nomes por ResultadoAlocacao: para o terminal e para os rótulos das métricas exportadas
+const char* const NOMES_MOTIVOS_FALHA[] = {"ok", "espaço insuficiente", "sem espaço contíguo", "índice cheio",
+                                           "limite de extents", "arquivo existente", "arquivo inexistente"};
+const char* const ROTULOS_MOTIVOS_FALHA[] = {"ok", "espaco_insuficiente", "sem_espaco_contiguo", "indice_cheio",
+                                             "limite_extents", "arquivo_existente", "arquivo_inexistente"};
+
+// retorna os blocos de dados do arquivo na ordem lógica
+vector<int> blocosDoArquivo(const File& file) {
+    vector<int> blocos;
+    if (file.metodo == METODO_EXTENTS) {
+        for (const auto& [inicio, tamanho] : file.extents)
+            for (int i = 0; i < tamanho; ++i) blocos.push_back(inicio + i);
+        return blocos;
+    }
+    if (file.metodo != METODO_CONTIGUO) return file.dataBlocks.paraVetor();
+    for (int i = 0; i < file.size; ++i) blocos.push_back(file.startBlock + i);
+    return blocos;
+}
+
+string nomeDoMetodo(int metodo) {
+    switch (metodo) {
+        case METODO_CONTIGUO: return "Contígua";
+        case METODO_ENCADEADO: return "Encadeada";
+        case METODO_INDEXADO: return "Indexada";
+        case METODO_EXTENTS: return "Extents";
+        case METODO_MISTO: return "Mista";
+        default: return "?";
+    }
+}
+
+// completa com espaços até a largura visível (setw conta bytes, e os acentos ocupam dois em UTF-8)
+string preencherColuna(const string& texto, size_t largura) {
+    size_t visiveis = count_if(texto.begin(), texto.end(), [](char c) { return (c & 0xC0) != 0x80; });
+    return visiveis >= largura ? texto : texto + string(largura - visiveis, ' ');
+}
+
+// resumo do espaço livre: total de blocos livres, quantidade de trechos livres e o maior trecho
+struct ResumoEspacoLivre {
+    int blocosLivres = 0;
+    int trechos = 0;
+    int maiorTrecho = 0;
+};
+
+ResumoEspacoLivre resumirEspacoLivre(const vector<int>& disk) {
+    ResumoEspacoLivre resumo;
+    int trechoAtual = 0;
+    for (size_t i = 0; i <= disk.size(); ++i) {
+        if (i < disk.size() && disk[i] == BLOCO_LIVRE) {
+            ++resumo.blocosLivres;
+            ++trechoAtual;
+        } else if (trechoAtual > 0) {
+            ++resumo.trechos;
+            resumo.maiorTrecho = max(resumo.maiorTrecho, trechoAtual);
+            trechoAtual = 0;
+        }
+    }
+    return resumo;
+}
+
+// lista os trechos livres do disco como pares (bloco inicial, tamanho)
+vector<pair<int,int>> listarTrechosLivres(const vector<int>& disk) {
+    vector<pair<int,int>> trechos;
+    int inicio = -1;
+    for (size_t i = 0; i <= disk.size(); ++i) {
+        bool livre = i < disk.size() && disk[i] == BLOCO_LIVRE;
+        if (livre && inicio == -1) {
+            inicio = (int)i;
+        } else if (!livre && inicio != -1) {
+            trechos.push_back({inicio, (int)i - inicio});
+            inicio = -1;
+        }
+    }
+    return trechos;
+}
+
+// ---------------- métricas do volume (atualização incremental) ----------------
+// as métricas do disco principal são mantidas a cada operação, sem percorrer o disco: criar, estender
+// e remover só tocam os blocos do arquivo envolvido, e cada bloco atualiza o mapa de trechos livres
+// em O(log n). O percurso completo (reconstruirMetricas) só acontece quando o disco é trocado inteiro
+// (imagem carregada, snapshot restaurado, reparo do fsck)
+constexpr int FAIXAS_HISTOGRAMA = 8; // trechos livres de 1, 2-3, 4-7, ..., 128+ blocos
+const long long LIMITES_LATENCIA[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000}; // ms
+constexpr int FAIXAS_LATENCIA = sizeof(LIMITES_LATENCIA) / sizeof(LIMITES_LATENCIA[0]);
+
+// contagem por faixa (não acumulada); a última posição guarda o que passa do maior limite
+struct HistogramaLatencia {
+    long long contagem[FAIXAS_LATENCIA + 1] = {};
+    long long soma = 0;
+    long long total = 0;
+};
+
+// diagnóstico de cada falha de alocação: separa "volume cheio" (faltam blocos livres) de "volume
+// fragmentado" (há blocos livres suficientes, mas não onde ou do jeito que o método precisa)
+enum CausaFalha { CAUSA_VOLUME_CHEIO, CAUSA_FRAGMENTACAO, CAUSA_LIMITE_METODO };
+const char* const NOMES_CAUSAS_FALHA[] = {"volume cheio", "volume fragmentado", "limite do método"};
+const char* const ROTULOS_CAUSAS_FALHA[] = {"volume_cheio", "volume_fragmentado", "limite_metodo"};
+constexpr int CELULAS_MAPA_CALOR = 32;  // o disco inteiro resumido em até 32 células
+constexpr size_t FALHAS_GUARDADAS = 16; // diagnósticos mais recentes mantidos
+
+struct DiagnosticoFalha {
+    ResultadoAlocacao motivo;
+    CausaFalha causa;
+    int blocosPedidos;
+    int blocosLivres;
+    int maiorTrecho;
+    string mapaCalor;                   // ocupação de cada célula: ' ' livre ... '█' cheia
+};
+
+struct DiagnosticosFalhas {
+    long long porCausa[3] = {};         // indexado por CausaFalha
+    long long somaPedidos = 0;          // para comparar o pedido médio com o maior trecho médio
+    long long somaMaiorTrecho = 0;
+    deque<DiagnosticoFalha> recentes;
+};
+
+// contadores cumulativos do volume: sobrevivem à reconstrução das métricas (imagem, snapshot, fsck)
+struct ContadoresVolume {
+    long long criacoes = 0, extensoes = 0, remocoes = 0;
+    long long falhas[ERRO_ARQUIVO_INEXISTENTE + 1] = {}; // indexado por ResultadoAlocacao
+    long long blocosAlocados = 0, blocosLiberados = 0;   // incluem os blocos índice
+    HistogramaLatencia latencias[4];                     // indexado por TipoOperacaoCarga (ms simulados)
+    DiagnosticosFalhas diagnosticos;
+};
+
+struct MetricasVolume {
+    const vector<int>* disco = nullptr; // disco acompanhado; discos de experimentos não mexem aqui
+    long long fragInterna = 0;          // bytes
+    int arquivos = 0;
+    long long trechosDosArquivos = 0;   // sequências de blocos fisicamente consecutivos, somadas
+    long long saltos = 0;               // blocos lógicos consecutivos que não são vizinhos no disco
+    long long distanciaSaltos = 0;      // soma de |b[i+1] - b[i]| nesses saltos
+    int blocosLivres = 0;
+    map<int, int> trechosLivres;        // início -> tamanho
+    map<int, int> tamanhosLivres;       // tamanho -> quantos trechos livres têm esse tamanho
+    long long histograma[FAIXAS_HISTOGRAMA] = {};
+    ContadoresVolume contadores;
+};
+
+MetricasVolume metricasVolume;
+// volume de uma execução em lote desta thread (clientes simulados), acompanhado junto com o principal
+thread_local MetricasVolume* metricasDoLote = nullptr;
+
+MetricasVolume* metricasDoDisco(const vector<int>& disk) {
+    if (metricasVolume.disco == &disk) return &metricasVolume;
+    return metricasDoLote && metricasDoLote->disco == &disk ? metricasDoLote : nullptr;
+}
+
+void registrarLatencia(HistogramaLatencia& h, long long ms) {
+    int faixa = 0;
+    while (faixa < FAIXAS_LATENCIA && ms > LIMITES_LATENCIA[faixa]) ++faixa;
+    h.contagem[faixa]++;
+    h.soma += ms;
+    h.total++;
+}
+
+// limite superior da faixa em que cai o percentil (estimativa a partir do histograma)
+long long percentilLatencia(const HistogramaLatencia& h, double fracao) {
+    if (h.total == 0) return 0;
+    long long acumulado = 0;
+    for (int faixa = 0; faixa < FAIXAS_LATENCIA; ++faixa) {
+        acumulado += h.contagem[faixa];
+        if (acumulado >= fracao * h.total) return LIMITES_LATENCIA[faixa];
+    }
+    return LIMITES_LATENCIA[FAIXAS_LATENCIA - 1] + 1;
+}
+
+int maiorTrechoLivre(const MetricasVolume& m) {
+    return m.tamanhosLivres.empty() ? 0 : m.tamanhosLivres.rbegin()->first;
+}
+
+// primeiro bloco da célula do mapa de calor (a última célula termina no fim do disco)
+long long inicioDaCelula(int celula, int celulas, long long totalBlocos) {
+    return ((long long)celula * totalBlocos + celulas - 1) / celulas;
+}
+
+// ocupação por célula calculada a partir dos trechos livres (sem percorrer o disco)
+string mapaDeCalor(const MetricasVolume& m) {
+    static const char* const NIVEIS[] = {" ", "░", "▒", "▓", "█"};
+    long long total = static_cast<long long>(m.disco->size());
+    int celulas = static_cast<int>(min<long long>(CELULAS_MAPA_CALOR, total));
+    vector<long long> livres(celulas, 0);
+    for (const auto& [inicio, tamanho] : m.trechosLivres) {
+        for (long long bloco = inicio, fim = inicio + tamanho; bloco < fim; ) {
+            int celula = static_cast<int>(bloco * celulas / total);
+            while (inicioDaCelula(celula + 1, celulas, total) <= bloco) ++celula;
+            long long fimCelula = min(fim, inicioDaCelula(celula + 1, celulas, total));
+            livres[celula] += fimCelula - bloco;
+            bloco = fimCelula;
+        }
+    }
+    string mapa;
+    for (int celula = 0; celula < celulas; ++celula) {
+        long long tamanho = inicioDaCelula(celula + 1, celulas, total) - inicioDaCelula(celula, celulas, total);
+        // arredonda para cima: qualquer bloco ocupado já aparece na célula
+        mapa += NIVEIS[(4 * (tamanho - livres[celula]) + tamanho - 1) / tamanho];
+    }
+    return mapa;
+}
+
+// as rotinas de alocação devolvem as falhas por aqui para contá-las por motivo e guardar o diagnóstico
+// (blocosPedidos inclui o bloco índice quando a indexada precisa de um)
+ResultadoAlocacao falhaAlocacao(const vector<int>& disk, ResultadoAlocacao motivo, int blocosPedidos) {
+    MetricasVolume* m = metricasDoDisco(disk);
+    if (m == nullptr) return motivo;
+    DiagnosticoFalha diagnostico{motivo, CAUSA_FRAGMENTACAO, blocosPedidos, m->blocosLivres, maiorTrechoLivre(*m),
+                                 mapaDeCalor(*m)};
+    if (motivo == ERRO_INDICE_CHEIO) diagnostico.causa = CAUSA_LIMITE_METODO;
+    else if (m->blocosLivres < blocosPedidos) diagnostico.causa = CAUSA_VOLUME_CHEIO;
+
+    DiagnosticosFalhas& diagnosticos = m->contadores.diagnosticos;
+    m->contadores.falhas[motivo]++;
+    diagnosticos.porCausa[diagnostico.causa]++;
+    diagnosticos.somaPedidos += blocosPedidos;
+    diagnosticos.somaMaiorTrecho += diagnostico.maiorTrecho;
+    diagnosticos.recentes.push_back(diagnostico);
+    if (diagnosticos.recentes.size() > FALHAS_GUARDADAS) diagnosticos.recentes.pop_front();
+    return motivo;
+}
+
+int faixaDoHistograma(int tamanho) {
+    int faixa = 0;
+    while (tamanho > 1 && faixa < FAIXAS_HISTOGRAMA - 1) {
+        tamanho >>= 1;
+        ++faixa;
+    }
+    return faixa;
+}
+
+void contarTrechoLivre(MetricasVolume& m, int tamanho, int sinal) {
+    m.histograma[faixaDoHistograma(tamanho)] += sinal;
+    if ((m.tamanhosLivres[tamanho] += sinal) == 0) m.tamanhosLivres.erase(tamanho);
+}
+
+void inserirTrechoLivre(MetricasVolume& m, int inicio, int tamanho) {
+    m.trechosLivres[inicio] = tamanho;
+    contarTrechoLivre(m, tamanho, +1);
+}
+
+void apagarTrechoLivre(MetricasVolume& m, map<int, int>::iterator it) {
+    contarTrechoLivre(m, it->second, -1);
+    m.trechosLivres.erase(it);
+}
+
+// bloco passou a ser usado: divide o trecho livre que o contém
+void ocuparBlocoMetricas(MetricasVolume& m, int bloco) {
+    auto it = m.trechosLivres.upper_bound(bloco);
+    if (it == m.trechosLivres.begin()) return;
+    --it;
+    auto [inicio, tamanho] = *it;
+    if (bloco >= inicio + tamanho) return;
+    apagarTrechoLivre(m, it);
+    if (bloco > inicio) inserirTrechoLivre(m, inicio, bloco - inicio);
+    if (bloco + 1 < inicio + tamanho) inserirTrechoLivre(m, bloco + 1, inicio + tamanho - bloco - 1);
+    m.blocosLivres--;
+}
+
+// bloco liberado: junta com os trechos livres vizinhos
+void liberarBlocoMetricas(MetricasVolume& m, int bloco) {
+    int inicio = bloco, tamanho = 1;
+    auto seguinte = m.trechosLivres.find(bloco + 1);
+    if (seguinte != m.trechosLivres.end()) {
+        tamanho += seguinte->second;
+        apagarTrechoLivre(m, seguinte);
+    }
+    auto anterior = m.trechosLivres.lower_bound(bloco);
+    if (anterior != m.trechosLivres.begin()) {
+        --anterior;
+        if (anterior->first + anterior->second == bloco) {
+            inicio = anterior->first;
+            tamanho += anterior->second;
+            apagarTrechoLivre(m, anterior);
+        }
+    }
+    inserirTrechoLivre(m, inicio, tamanho);
+    m.blocosLivres++;
+}
+
+// trechos e saltos entre os blocos [desde, fim) da lista e o bloco anterior a cada um
+void contarSaltos(MetricasVolume& m, const vector<int>& blocos, size_t desde, int sinal) {
+    for (size_t i = max<size_t>(desde, 1); i < blocos.size(); ++i) {
+        if (blocos[i] == blocos[i - 1] + 1) continue;
+        m.trechosDosArquivos += sinal;
+        m.saltos += sinal;
+        m.distanciaSaltos += sinal * (long long)abs(blocos[i] - blocos[i - 1]);
+    }
+}
+
+void metricasArquivoCriado(const vector<int>& disk, const File& file) {
+    MetricasVolume* m = metricasDoDisco(disk);
+    if (m == nullptr) return;
+    vector<int> blocos = blocosDoArquivo(file);
+    m->arquivos++;
+    m->fragInterna += computeFragmentation(file.size, file.sizeBytes);
+    if (!blocos.empty()) m->trechosDosArquivos++;
+    contarSaltos(*m, blocos, 0, +1);
+    for (int bloco : blocos) ocuparBlocoMetricas(*m, bloco);
+    if (file.metodo == METODO_INDEXADO) ocuparBlocoMetricas(*m, file.indexBlock);
+    m->contadores.criacoes++;
+    m->contadores.blocosAlocados += blocos.size() + (file.metodo == METODO_INDEXADO);
+}
+
+// extensão: os blocos antigos continuam na mesma ordem, só os novos (do fim da lista) entram
+void metricasArquivoEstendido(const vector<int>& disk, const File& file, int blocosAntes, int bytesAntes) {
+    MetricasVolume* m = metricasDoDisco(disk);
+    if (m == nullptr) return;
+    vector<int> blocos = blocosDoArquivo(file);
+    m->fragInterna += computeFragmentation(file.size, file.sizeBytes) - computeFragmentation(blocosAntes, bytesAntes);
+    if (blocosAntes == 0 && !blocos.empty()) m->trechosDosArquivos++;
+    contarSaltos(*m, blocos, blocosAntes, +1);
+    for (size_t i = blocosAntes; i < blocos.size(); ++i) ocuparBlocoMetricas(*m, blocos[i]);
+    m->contadores.extensoes++;
+    m->contadores.blocosAlocados += blocos.size() - blocosAntes;
+}
+
+void metricasArquivoRemovido(const vector<int>& disk, const File& file) {
+    MetricasVolume* m = metricasDoDisco(disk);
+    if (m == nullptr) return;
+    vector<int> blocos = blocosDoArquivo(file);
+    m->arquivos--;
+    m->fragInterna -= computeFragmentation(file.size, file.sizeBytes);
+    if (!blocos.empty()) m->trechosDosArquivos--;
+    contarSaltos(*m, blocos, 0, -1);
+    for (int bloco : blocos) liberarBlocoMetricas(*m, bloco);
+    if (file.metodo == METODO_INDEXADO) liberarBlocoMetricas(*m, file.indexBlock);
+    m->contadores.remocoes++;
+    m->contadores.blocosLiberados += blocos.size() + (file.metodo == METODO_INDEXADO);
+}
+
+// percurso completo: passa a acompanhar este disco a partir do estado atual (os contadores continuam)
+void reconstruirMetricas(const vector<int>& disk,
+                         const unordered_map<string, File>& filesContiguous,
+                         const unordered_map<string, File>& filesEncadeados,
+                         const unordered_map<string, File>& filesIndexados,
+                         const unordered_map<string, File>& filesExtents,
+                         MetricasVolume& m = metricasVolume) {
+    ContadoresVolume contadores = m.contadores;
+    m = MetricasVolume();
+    m.disco = &disk;
+    m.contadores = contadores;
+    for (const auto& [inicio, tamanho] : listarTrechosLivres(disk)) {
+        inserirTrechoLivre(m, inicio, tamanho);
+        m.blocosLivres += tamanho;
+    }
+    for (const auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+        for (const auto& [nome, file] : *files) {
+            vector<int> blocos = blocosDoArquivo(file);
+            m.arquivos++;
+            m.fragInterna += computeFragmentation(file.size, file.sizeBytes);
+            if (!blocos.empty()) m.trechosDosArquivos++;
+            contarSaltos(m, blocos, 0, +1);
+        }
+    }
+}
+
+// 0 = todo o espaço livre num único trecho; perto de 1 = espaço livre pulverizado
+double indiceFragExterna(const MetricasVolume& m) {
+    return m.blocosLivres ? 1.0 - (double)maiorTrechoLivre(m) / m.blocosLivres : 0.0;
+}
+
+bool mesmasMetricas(const MetricasVolume& a, const MetricasVolume& b) {
+    return a.fragInterna == b.fragInterna && a.arquivos == b.arquivos &&
+           a.trechosDosArquivos == b.trechosDosArquivos && a.saltos == b.saltos &&
+           a.distanciaSaltos == b.distanciaSaltos && a.blocosLivres == b.blocosLivres &&
+           a.trechosLivres == b.trechosLivres;
+}
+
+void imprimirDiagnosticoFalha(const DiagnosticoFalha& diagnostico, const string& recuo = "  ") {
+    cout << recuo << "Pedido: " << diagnostico.blocosPedidos << " bloco(s) | livres: " << diagnostico.blocosLivres
+         << " | maior trecho livre: " << diagnostico.maiorTrecho << " -> " << NOMES_CAUSAS_FALHA[diagnostico.causa]
+         << "\n" << recuo << "Ocupação do disco: [" << diagnostico.mapaCalor << "]\n";
+}
+
+// relatório das falhas: quantas por causa, pedido médio contra o maior trecho médio e as mais recentes
+void displayDiagnosticoFalhas(const DiagnosticosFalhas& diagnosticos, size_t recentes = 4) {
+    long long total = 0;
+    for (long long quantidade : diagnosticos.porCausa) total += quantidade;
+    if (total == 0) return;
+    cout << "  Causas das falhas:";
+    for (int causa = CAUSA_VOLUME_CHEIO; causa <= CAUSA_LIMITE_METODO; ++causa) {
+        cout << " " << NOMES_CAUSAS_FALHA[causa] << "=" << diagnosticos.porCausa[causa] << " ("
+             << fixed << setprecision(0) << 100.0 * diagnosticos.porCausa[causa] / total << "%)";
+    }
+    cout << setprecision(1) << "\n  Pedido médio: " << (double)diagnosticos.somaPedidos / total
+         << " bloco(s) | maior trecho livre médio no momento da falha: "
+         << (double)diagnosticos.somaMaiorTrecho / total << " bloco(s)\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    size_t mostrar = min(recentes, diagnosticos.recentes.size());
+    if (mostrar > 0) cout << "  Falhas mais recentes:\n";
+    for (size_t i = diagnosticos.recentes.size() - mostrar; i < diagnosticos.recentes.size(); ++i) {
+        cout << "  - " << NOMES_MOTIVOS_FALHA[diagnosticos.recentes[i].motivo] << ":\n";
+        imprimirDiagnosticoFalha(diagnosticos.recentes[i], "      ");
+    }
+}
+
+// diagnóstico da falha que acabou de acontecer no disco principal
+void imprimirUltimoDiagnostico() {
+    const deque<DiagnosticoFalha>& recentes = metricasVolume.contadores.diagnosticos.recentes;
+    if (!recentes.empty()) imprimirDiagnosticoFalha(recentes.back());
+}
+
+void displayMetricasVolume(const MetricasVolume& m = metricasVolume) {
+    EscopoRastro rastro("displayMetricasVolume");
+    cout << "\nMétricas do volume (atualizadas a cada operação):\n";
+    cout << "  Fragmentação interna: " << m.fragInterna << " bytes\n";
+    cout << "  Blocos livres: " << m.blocosLivres << " em " << m.trechosLivres.size()
+         << " trecho(s) | maior trecho: " << maiorTrechoLivre(m) << " bloco(s) | índice de fragmentação externa: "
+         << fixed << setprecision(2) << indiceFragExterna(m) << "\n";
+    cout << "  Trechos livres por tamanho:";
+    for (int faixa = 0; faixa < FAIXAS_HISTOGRAMA; ++faixa) {
+        int minimo = 1 << faixa;
+        string faixaTexto = faixa == 0 ? "1" : faixa == FAIXAS_HISTOGRAMA - 1 ? to_string(minimo) + "+"
+                          : to_string(minimo) + "-" + to_string(2 * minimo - 1);
+        cout << " [" << faixaTexto << "]=" << m.histograma[faixa];
+    }
+    cout << "\n";
+    if (m.arquivos > 0) {
+        cout << "  Trechos por arquivo: " << (double)m.trechosDosArquivos / m.arquivos << " | saltos entre blocos: "
+             << m.saltos << " (distância média " << (m.saltos ? (double)m.distanciaSaltos / m.saltos : 0.0)
+             << " blocos)\n";
+    }
+    const ContadoresVolume& c = m.contadores;
+    cout << "  Operações: " << c.criacoes << " criação(ões), " << c.extensoes << " extensão(ões), " << c.remocoes
+         << " remoção(ões) | blocos alocados: " << c.blocosAlocados << ", liberados: " << c.blocosLiberados << "\n";
+    cout << "  Falhas de alocação:";
+    long long totalFalhas = 0;
+    for (int motivo = ERRO_ESPACO_INSUFICIENTE; motivo <= ERRO_ARQUIVO_INEXISTENTE; ++motivo) {
+        if (c.falhas[motivo] == 0) continue;
+        cout << " " << NOMES_MOTIVOS_FALHA[motivo] << "=" << c.falhas[motivo];
+        totalFalhas += c.falhas[motivo];
+    }
+    cout << (totalFalhas ? "\n" : " nenhuma\n");
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    displayDiagnosticoFalhas(c.diagnosticos);
+}
+
+// ---------------- exportação de métricas (Prometheus / CSV) ----------------
+// as execuções em lote gravam uma amostra a cada período de tempo simulado: no formato de exposição do
+// Prometheus o arquivo é substituído a cada amostra (leitura pelo textfile collector do node_exporter);
+// em CSV cada amostra vira uma linha, formando a série temporal do envelhecimento do volume
+enum FormatoExportacao { EXPORTACAO_DESATIVADA, EXPORTACAO_PROMETHEUS, EXPORTACAO_CSV };
+
+struct ExportacaoMetricas {
+    int formato = EXPORTACAO_DESATIVADA;
+    string caminho;
+    long long periodo = 60 * 1000;   // ms de tempo simulado entre duas amostras
+    long long amostras = 0;
 };
 
+ExportacaoMetricas exportacaoMetricas;
+
+const char* const ROTULOS_OPERACOES[] = {"criar", "estender", "remover", "ler"};
+
+void escreverPrometheus(ostream& saida, const MetricasVolume& m, const string& execucao, long long instante) {
+    const ContadoresVolume& c = m.contadores;
+    string rotulo = "execucao=\"" + execucao + "\"";
+    auto metrica = [&](const char* nome, const char* tipo, const char* ajuda, auto valor) {
+        saida << "# HELP " << nome << " " << ajuda << "\n# TYPE " << nome << " " << tipo << "\n"
+              << nome << "{" << rotulo << "} " << valor << "\n";
+    };
+    metrica("tde_criacoes_total", "counter", "Arquivos criados.", c.criacoes);
+    metrica("tde_extensoes_total", "counter", "Extensões de arquivos concluídas.", c.extensoes);
+    metrica("tde_remocoes_total", "counter", "Arquivos removidos.", c.remocoes);
+    metrica("tde_blocos_alocados_total", "counter", "Blocos entregues pelo alocador (dados e índice).",
+            c.blocosAlocados);
+    metrica("tde_blocos_liberados_total", "counter", "Blocos devolvidos ao espaço livre.", c.blocosLiberados);
+    saida << "# HELP tde_falhas_alocacao_total Pedidos de alocação recusados, por motivo.\n"
+          << "# TYPE tde_falhas_alocacao_total counter\n";
+    for (int motivo = ERRO_ESPACO_INSUFICIENTE; motivo <= ERRO_ARQUIVO_INEXISTENTE; ++motivo) {
+        saida << "tde_falhas_alocacao_total{" << rotulo << ",motivo=\"" << ROTULOS_MOTIVOS_FALHA[motivo] << "\"} "
+              << c.falhas[motivo] << "\n";
+    }
+    saida << "# HELP tde_falhas_por_causa_total Falhas de alocação por causa (volume cheio ou fragmentado).\n"
+          << "# TYPE tde_falhas_por_causa_total counter\n";
+    for (int causa = CAUSA_VOLUME_CHEIO; causa <= CAUSA_LIMITE_METODO; ++causa) {
+        saida << "tde_falhas_por_causa_total{" << rotulo << ",causa=\"" << ROTULOS_CAUSAS_FALHA[causa] << "\"} "
+              << c.diagnosticos.porCausa[causa] << "\n";
+    }
+    metrica("tde_blocos_livres", "gauge", "Blocos livres no volume.", m.blocosLivres);
+    metrica("tde_maior_trecho_livre_blocos", "gauge", "Maior trecho livre contíguo.", maiorTrechoLivre(m));
+    metrica("tde_trechos_livres", "gauge", "Trechos livres no volume.", m.trechosLivres.size());
+    metrica("tde_fragmentacao_externa", "gauge", "1 - maior trecho livre / blocos livres.", indiceFragExterna(m));
+    metrica("tde_fragmentacao_interna_bytes", "gauge", "Bytes desperdiçados no último bloco dos arquivos.",
+            m.fragInterna);
+    metrica("tde_arquivos", "gauge", "Arquivos no volume.", m.arquivos);
+    metrica("tde_tempo_simulado_ms", "gauge", "Instante simulado da amostra.", instante);
+    saida << "# HELP tde_latencia_operacao_ms Latência das operações em tempo simulado.\n"
+          << "# TYPE tde_latencia_operacao_ms histogram\n";
+    for (int op = 0; op < 4; ++op) {
+        const HistogramaLatencia& h = c.latencias[op];
+        string rotulos = rotulo + ",operacao=\"" + ROTULOS_OPERACOES[op] + "\"";
+        long long acumulado = 0;
+        for (int faixa = 0; faixa < FAIXAS_LATENCIA; ++faixa) {
+            acumulado += h.contagem[faixa];
+            saida << "tde_latencia_operacao_ms_bucket{" << rotulos << ",le=\"" << LIMITES_LATENCIA[faixa] << "\"} "
+                  << acumulado << "\n";
+        }
+        saida << "tde_latencia_operacao_ms_bucket{" << rotulos << ",le=\"+Inf\"} " << h.total << "\n"
+              << "tde_latencia_operacao_ms_sum{" << rotulos << "} " << h.soma << "\n"
+              << "tde_latencia_operacao_ms_count{" << rotulos << "} " << h.total << "\n";
+    }
+}
+
+void escreverCabecalhoCsv(ostream& saida) {
+    saida << "execucao,instante_ms,criacoes,extensoes,remocoes,blocos_alocados,blocos_liberados";
+    for (int motivo = ERRO_ESPACO_INSUFICIENTE; motivo <= ERRO_ARQUIVO_INEXISTENTE; ++motivo)
+        saida << ",falhas_" << ROTULOS_MOTIVOS_FALHA[motivo];
+    for (const char* causa : ROTULOS_CAUSAS_FALHA) saida << ",causa_" << causa;
+    saida << ",blocos_livres,maior_trecho_livre,trechos_livres,fragmentacao_externa,fragmentacao_interna_bytes,arquivos";
+    for (const char* op : ROTULOS_OPERACOES) saida << ",latencia_media_" << op << ",latencia_p99_" << op;
+    saida << "\n";
+}
+
+void escreverLinhaCsv(ostream& saida, const MetricasVolume& m, const string& execucao, long long instante) {
+    const ContadoresVolume& c = m.contadores;
+    saida << execucao << "," << instante << "," << c.criacoes << "," << c.extensoes << "," << c.remocoes << ","
+          << c.blocosAlocados << "," << c.blocosLiberados;
+    for (int motivo = ERRO_ESPACO_INSUFICIENTE; motivo <= ERRO_ARQUIVO_INEXISTENTE; ++motivo)
+        saida << "," << c.falhas[motivo];
+    for (long long quantidade : c.diagnosticos.porCausa) saida << "," << quantidade;
+    saida << "," << m.blocosLivres << "," << maiorTrechoLivre(m) << "," << m.trechosLivres.size() << ","
+          << fixed << setprecision(4) << indiceFragExterna(m) << "," << m.fragInterna << "," << m.arquivos;
+    for (const HistogramaLatencia& h : c.latencias) {
+        saida << "," << setprecision(2) << (h.total ? (double)h.soma / h.total : 0.0) << ","
+              << percentilLatencia(h, 0.99);
+    }
+    saida << "\n";
+}
+
+// grava uma amostra no destino configurado; devolve false se a exportação está desativada ou falhou
+bool exportarAmostra(const MetricasVolume& m, const string& execucao, long long instante) {
+    ExportacaoMetricas& exportacao = exportacaoMetricas;
+    if (exportacao.formato == EXPORTACAO_DESATIVADA) return false;
+    if (exportacao.formato == EXPORTACAO_CSV) {
+        ofstream saida(exportacao.caminho, ios::app);
+        if (!saida) return false;
+        escreverLinhaCsv(saida, m, execucao, instante);
+    } else {
+        // grava ao lado e renomeia: quem lê o arquivo nunca vê uma amostra pela metade
+        string temporario = exportacao.caminho + ".tmp";
+        {
+            ofstream saida(temporario, ios::trunc);
+            if (!saida) return false;
+            escreverPrometheus(saida, m, execucao, instante);
+        }
+        if (rename(temporario.c_str(), exportacao.caminho.c_str()) != 0) return false;
+    }
+    exportacao.amostras++;
+    return true;
+}
+
+void exportacaoMetricasMenu() {
+    int formato;
+    cout << "Exportação de métricas: 0 - desativar, 1 - Prometheus (texto de exposição), 2 - CSV: ";
+    cin >> formato;
+    if (cin.fail() || formato < EXPORTACAO_DESATIVADA || formato > EXPORTACAO_CSV) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Opção inválida!" << endl;
+        return;
+    }
+    ExportacaoMetricas& exportacao = exportacaoMetricas;
+    exportacao.formato = formato;
+    if (formato == EXPORTACAO_DESATIVADA) {
+        cout << "Exportação desativada." << endl;
+        return;
+    }
+
+    double segundos;
+    cout << "Arquivo de destino: ";
+    cin >> exportacao.caminho;
+    cout << "Período entre amostras nas execuções em lote (segundos simulados): ";
+    cin >> segundos;
+    if (cin.fail() || segundos <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Período inválido!" << endl;
+        exportacao.formato = EXPORTACAO_DESATIVADA;
+        return;
+    }
+    exportacao.periodo = max(1LL, static_cast<long long>(segundos * 1000));
+    exportacao.amostras = 0;
+
+    if (formato == EXPORTACAO_CSV) {
+        ofstream saida(exportacao.caminho, ios::trunc);
+        if (saida) escreverCabecalhoCsv(saida);
+    }
+    // primeira amostra: o volume do menu interativo, no estado atual
+    if (!exportarAmostra(metricasVolume, "interativo", 0)) {
+        cout << "Erro: não foi possível gravar em " << exportacao.caminho << endl;
+        exportacao.formato = EXPORTACAO_DESATIVADA;
+        return;
+    }
+    cout << "Métricas do volume gravadas em " << exportacao.caminho << "; os clientes simulados (opção 18) gravam "
+         << "uma amostra a cada " << segundos << " s simulados." << endl;
+}
+
+template <typename Map>
 bool promptCreateCommon(
-    const unordered_map<string, File>& files,
+    const Map& files,
     const vector<int>& disk,
     string& fileNameOut,
     int& tamanhoBytesOut,
     int& tamanhoBlocosOut)
 {
+    EscopoRastro rastro("promptCreateCommon");
     cout << "Digite o nome do arquivo: ";
     cin >> fileNameOut;
 
-    // verifica se o arquivo já existe
-    if (files.find(fileNameOut) != files.end()) {
+    // verifica se o arquivo já existe (nomes são únicos no disco, independente do método)
+    if (files.find(fileNameOut) != files.end() || tabelaDiretorio.find(fileNameOut) != tabelaDiretorio.end()) {
         cout << "Erro: Arquivo já existe!" << endl;
         return false;
     }
@@ -94,6 +1109,11 @@ bool promptCreateCommon(
     cout << "Digite o tamanho do arquivo em bytes: ";
     cin >> tamanhoBytesOut;
 
+    if (tamanhoBytesOut <= 0) {
+        cout << "Erro: Tamanho inválido para o arquivo." << endl;
+        return false;
+    }
+
     // calcula o número de blocos necessários (arredondando para cima)
     tamanhoBlocosOut = (tamanhoBytesOut + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
 
@@ -144,41 +1164,254 @@ string getFileColor(int fileID) {
     return colors[fileID % colors.size()];
 }
 
-// map que associa cada arquivo a uma tuple (startBlock, size) representando a tabela de diretório
-unordered_map<string, tuple<int, int>> tabelaDiretorio;
-
-// display no terminal para cada método de alocação
-void displayContiguo(const vector<int>& disk, const unordered_map<string, File>& files) {
-    cout << "Memória Contígua:" << endl;
-
-    int totalBytesLivres = 0;
+// ---------------- mapa compacto do disco (trechos e zoom) ----------------
+// em vez de uma linha por bloco, o disco vira uma lista de trechos (blocos consecutivos com o mesmo dono
+// e o mesmo estado). Os ocupados vêm dos trechos já guardados em cada arquivo (startBlock, extents ou os
+// trechos da ListaBlocos, sem expandir bloco a bloco) e os livres do mapa das métricas, recortados ao
+// intervalo pedido; montar custa O(T log T) para T trechos, sem passar pelo vetor do disco. Intervalos
+// grandes são agregados em células de N blocos, mostrando o dono predominante e a ocupação de cada célula
+constexpr int LIMITE_DESENHO_POR_BLOCO = 256; // acima disso os display* mostram o mapa compacto
+constexpr int CELULAS_POR_LINHA = 64;
+constexpr int CELULAS_AUTOMATICAS = 512;      // blocos por célula automático: o intervalo em até 8 linhas
+constexpr int TRECHOS_NA_LISTA = 64;          // até quantos trechos o modo automático lista um por linha
+
+struct TrechoMapa {
+    int inicio;
+    int tamanho;
+    const File* dono;   // nullptr = livre
+    bool indice;        // bloco índice da indexada
+};
 
-    for (size_t i = 0; i < disk.size(); ++i) { // percorre cada bloco do disco
-        if (disk[i] == BLOCO_LIVRE) { // bloco livre
-            printFreeBlock(i);
-            cout << endl;
-            totalBytesLivres += TAMANHO_BLOCO;
-        } else { // bloco ocupado
-            int startBlock = disk[i];
-            
-            auto it = find_if(files.begin(), files.end(), [startBlock](const auto& p) { 
-                return p.second.startBlock == startBlock; 
-            });
-            
-            if (it == files.end()) {
-                cout << "[" << i << "] ?" << endl;
+// trechos que tocam [primeiro, ultimo], já recortados ao intervalo
+vector<TrechoMapa> trechosDoMapa(const vector<int>& disk,
+                                 initializer_list<const unordered_map<string, File>*> mapas,
+                                 int primeiro = 0, int ultimo = INT_MAX) {
+    vector<TrechoMapa> trechos;
+    auto acrescentar = [&](int inicio, int tamanho, const File* dono, bool indice) {
+        int fim = min(inicio + tamanho - 1, ultimo);
+        inicio = max(inicio, primeiro);
+        if (inicio <= fim) trechos.push_back({inicio, fim - inicio + 1, dono, indice});
+    };
+    for (const auto* files : mapas) {
+        for (const auto& [nome, file] : *files) {
+            if (file.metodo == METODO_CONTIGUO) {
+                if (file.size > 0) acrescentar(file.startBlock, file.size, &file, false);
                 continue;
             }
-            
-            const File& file = it->second;
-
-            int bytesUsed = TAMANHO_BLOCO;
-
-                int totalBytes = file.sizeBytes;
-                int totalBlocks = file.size;
-                int lastBlockIndexAbs = file.startBlock + file.size - 1;
-                if (static_cast<int>(i) == lastBlockIndexAbs) {
-                    bytesUsed = bytesUsedForBlock(totalBytes, totalBlocks - 1, totalBlocks);
+            if (file.metodo == METODO_EXTENTS) {
+                for (const auto& [inicio, tamanho] : file.extents) acrescentar(inicio, tamanho, &file, false);
+                continue;
+            }
+            // encadeada e indexada: trechos na ordem lógica; os vizinhos no disco se juntam depois da ordenação
+            file.dataBlocks.paraCadaTrecho([&](int inicio, int tamanho) { acrescentar(inicio, tamanho, &file, false); });
+            if (file.metodo == METODO_INDEXADO) acrescentar(file.indexBlock, 1, &file, true);
+        }
+    }
+    if (const MetricasVolume* m = metricasDoDisco(disk)) {
+        // o trecho livre que começa antes de "primeiro" ainda pode cobri-lo
+        auto it = m->trechosLivres.upper_bound(primeiro);
+        if (it != m->trechosLivres.begin()) --it;
+        for (; it != m->trechosLivres.end() && it->first <= ultimo; ++it) acrescentar(it->first, it->second, nullptr, false);
+    } else {
+        // disco sem métricas associadas: varre só o intervalo pedido
+        int fim = min(ultimo, static_cast<int>(disk.size()) - 1);
+        for (int i = max(0, primeiro), j; i <= fim; i = j) {
+            for (j = i; j <= fim && (disk[j] == BLOCO_LIVRE) == (disk[i] == BLOCO_LIVRE); ++j) {}
+            if (disk[i] == BLOCO_LIVRE) acrescentar(i, j - i, nullptr, false);
+        }
+    }
+    sort(trechos.begin(), trechos.end(), [](const TrechoMapa& a, const TrechoMapa& b) { return a.inicio < b.inicio; });
+
+    // junta trechos vizinhos do mesmo dono e estado (por exemplo, dois extents adjacentes)
+    vector<TrechoMapa> juntos;
+    for (const TrechoMapa& trecho : trechos) {
+        if (!juntos.empty() && juntos.back().dono == trecho.dono && juntos.back().indice == trecho.indice &&
+            juntos.back().inicio + juntos.back().tamanho == trecho.inicio) {
+            juntos.back().tamanho += trecho.tamanho;
+        } else {
+            juntos.push_back(trecho);
+        }
+    }
+    return juntos;
+}
+
+// primeiro trecho que termina depois de "bloco" (busca binária)
+size_t primeiroTrechoAPartir(const vector<TrechoMapa>& trechos, int bloco) {
+    return partition_point(trechos.begin(), trechos.end(),
+                           [bloco](const TrechoMapa& t) { return t.inicio + t.tamanho <= bloco; }) - trechos.begin();
+}
+
+size_t contarTrechosNoIntervalo(const vector<TrechoMapa>& trechos, int primeiro, int ultimo) {
+    size_t contagem = 0;
+    for (size_t k = primeiroTrechoAPartir(trechos, primeiro); k < trechos.size() && trechos[k].inicio <= ultimo; ++k)
+        ++contagem;
+    return contagem;
+}
+
+void printLinhaTrecho(int inicio, int fim, const TrechoMapa* trecho) {
+    cout << preencherColuna("[" + to_string(inicio) + "-" + to_string(fim) + "]", 16);
+    int tamanho = fim - inicio + 1;
+    if (trecho == nullptr) {
+        cout << "???? sem dono (" << tamanho << " bloco(s))\n";
+    } else if (trecho->dono == nullptr) {
+        cout << "░░░░ livre (" << tamanho << " bloco(s))\n";
+    } else {
+        cout << trecho->dono->color << "████\033[0m " << trecho->dono->name
+             << (trecho->indice ? " (bloco índice)" : " (" + to_string(tamanho) + " bloco(s))") << "\n";
+    }
+}
+
+// uma linha por trecho no intervalo [primeiro, ultimo]; lacunas são blocos ocupados sem dono conhecido
+void displayTrechosMapa(const vector<TrechoMapa>& trechos, int primeiro, int ultimo) {
+    int posicao = primeiro;
+    for (size_t k = primeiroTrechoAPartir(trechos, primeiro); k < trechos.size() && trechos[k].inicio <= ultimo; ++k) {
+        const TrechoMapa& trecho = trechos[k];
+        if (trecho.inicio > posicao) printLinhaTrecho(posicao, trecho.inicio - 1, nullptr);
+        int inicio = max(trecho.inicio, primeiro);
+        int fim = min(trecho.inicio + trecho.tamanho - 1, ultimo);
+        printLinhaTrecho(inicio, fim, &trecho);
+        posicao = fim + 1;
+    }
+    if (posicao <= ultimo) printLinhaTrecho(posicao, ultimo, nullptr);
+}
+
+// células de blocosPorCelula blocos: cor do dono predominante e símbolo pela ocupação
+void displayMapaAgregado(const vector<TrechoMapa>& trechos, int primeiro, int ultimo, int blocosPorCelula) {
+    static const char* const NIVEIS[] = {"·", "░", "▒", "▓", "█"};
+    int numCelulas = (ultimo - primeiro) / blocosPorCelula + 1;
+    map<const File*, long long> blocosPorDono;
+    size_t k = primeiroTrechoAPartir(trechos, primeiro);
+    vector<pair<const File*, int>> donosDaCelula;
+    for (int celula = 0; celula < numCelulas; ++celula) {
+        int inicio = primeiro + celula * blocosPorCelula;
+        int fim = min(ultimo, inicio + blocosPorCelula - 1);
+        int livres = 0;
+        donosDaCelula.clear();
+        // percorre os trechos que tocam a célula; o último pode continuar na próxima
+        for (size_t t = k; t < trechos.size() && trechos[t].inicio <= fim; ++t) {
+            const TrechoMapa& trecho = trechos[t];
+            int sobreposicao = min(fim, trecho.inicio + trecho.tamanho - 1) - max(inicio, trecho.inicio) + 1;
+            if (sobreposicao <= 0) continue;
+            if (trecho.dono == nullptr) {
+                livres += sobreposicao;
+                continue;
+            }
+            auto it = find_if(donosDaCelula.begin(), donosDaCelula.end(),
+                              [&](const auto& par) { return par.first == trecho.dono; });
+            if (it == donosDaCelula.end()) donosDaCelula.push_back({trecho.dono, sobreposicao});
+            else it->second += sobreposicao;
+            blocosPorDono[trecho.dono] += sobreposicao;
+        }
+        while (k < trechos.size() && trechos[k].inicio + trechos[k].tamanho - 1 <= fim) ++k;
+
+        int tamanho = fim - inicio + 1;
+        int nivel = static_cast<int>((4LL * (tamanho - livres) + tamanho - 1) / tamanho);
+        auto predominante = max_element(donosDaCelula.begin(), donosDaCelula.end(),
+                                        [](const auto& a, const auto& b) { return a.second < b.second; });
+        if (celula % CELULAS_POR_LINHA == 0) cout << (celula ? "\n" : "") << setw(8) << inicio << " ";
+        if (predominante != donosDaCelula.end()) cout << predominante->first->color << NIVEIS[nivel] << "\033[0m";
+        else cout << NIVEIS[nivel];
+    }
+    cout << "\n  Ocupação da célula: · vazia  ░ até 25%  ▒ até 50%  ▓ até 75%  █ acima; cor = dono predominante\n";
+
+    // legenda: os donos com mais blocos no intervalo
+    vector<pair<long long, const File*>> donos;
+    for (const auto& [dono, blocos] : blocosPorDono) donos.push_back({blocos, dono});
+    sort(donos.begin(), donos.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    if (!donos.empty()) cout << "  Maiores donos:";
+    for (size_t i = 0; i < donos.size() && i < 8; ++i)
+        cout << " " << donos[i].second->color << "■\033[0m " << donos[i].second->name << " (" << donos[i].first << ")";
+    if (donos.size() > 8) cout << " e mais " << donos.size() - 8;
+    if (!donos.empty()) cout << "\n";
+}
+
+// blocosPorCelula = 0 escolhe sozinho: lista os trechos se forem poucos, senão agrega em até 512 células
+void displayMapaCompacto(const vector<int>& disk, initializer_list<const unordered_map<string, File>*> mapas,
+                         int primeiro, int ultimo, int blocosPorCelula) {
+    EscopoRastro rastro("displayMapaCompacto");
+    if (disk.empty()) return;
+    primeiro = max(0, primeiro);
+    ultimo = min(ultimo, static_cast<int>(disk.size()) - 1);
+    if (primeiro > ultimo) {
+        cout << "Intervalo vazio." << endl;
+        return;
+    }
+    vector<TrechoMapa> trechos = trechosDoMapa(disk, mapas, primeiro, ultimo);
+    size_t noIntervalo = contarTrechosNoIntervalo(trechos, primeiro, ultimo);
+    int blocos = ultimo - primeiro + 1;
+    if (blocosPorCelula <= 0) {
+        blocosPorCelula = noIntervalo <= TRECHOS_NA_LISTA ? 1 : (blocos + CELULAS_AUTOMATICAS - 1) / CELULAS_AUTOMATICAS;
+    }
+    cout << "Mapa do disco: blocos " << primeiro << "-" << ultimo << ", " << noIntervalo << " trecho(s)";
+    if (blocosPorCelula == 1) {
+        cout << "\n";
+        displayTrechosMapa(trechos, primeiro, ultimo);
+        return;
+    }
+    cout << ", " << blocosPorCelula << " bloco(s) por célula\n";
+    displayMapaAgregado(trechos, primeiro, ultimo, blocosPorCelula);
+}
+
+void mapaCompactoMenu(const vector<int>& disk,
+                      const unordered_map<string, File>& filesContiguous,
+                      const unordered_map<string, File>& filesEncadeados,
+                      const unordered_map<string, File>& filesIndexados,
+                      const unordered_map<string, File>& filesExtents) {
+    int primeiro, ultimo, blocosPorCelula;
+    cout << "Primeiro bloco: ";
+    cin >> primeiro;
+    cout << "Último bloco (-1 = fim do disco): ";
+    cin >> ultimo;
+    cout << "Blocos por célula (0 = automático, 1 = um trecho por linha): ";
+    cin >> blocosPorCelula;
+    if (cin.fail() || primeiro < 0 || ultimo < -1 || blocosPorCelula < 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Valores inválidos!" << endl;
+        return;
+    }
+    if (ultimo == -1) ultimo = static_cast<int>(disk.size()) - 1;
+    displayMapaCompacto(disk, {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}, primeiro, ultimo,
+                        blocosPorCelula);
+}
+
+// display no terminal para cada método de alocação
+void displayContiguo(const vector<int>& disk, const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayContiguo");
+    if (disk.size() > LIMITE_DESENHO_POR_BLOCO) {
+        displayMapaCompacto(disk, {&files}, 0, static_cast<int>(disk.size()) - 1, 0);
+        return;
+    }
+    cout << "Memória Contígua:" << endl;
+
+    int totalBytesLivres = 0;
+
+    for (size_t i = 0; i < disk.size(); ++i) { // percorre cada bloco do disco
+        if (disk[i] == BLOCO_LIVRE) { // bloco livre
+            printFreeBlock(i);
+            cout << endl;
+            totalBytesLivres += TAMANHO_BLOCO;
+        } else { // bloco ocupado
+            int startBlock = disk[i];
+            
+            auto it = find_if(files.begin(), files.end(), [startBlock](const auto& p) { 
+                return p.second.startBlock == startBlock; 
+            });
+            
+            if (it == files.end()) {
+                cout << "[" << i << "] ?" << endl;
+                continue;
+            }
+            
+            const File& file = it->second;
+
+            int bytesUsed = TAMANHO_BLOCO;
+
+                int totalBytes = file.sizeBytes;
+                int totalBlocks = file.size;
+                int lastBlockIndexAbs = file.startBlock + file.size - 1;
+                if (static_cast<int>(i) == lastBlockIndexAbs) {
+                    bytesUsed = bytesUsedForBlock(totalBytes, totalBlocks - 1, totalBlocks);
                 }
 
             // imprime o bloco com cor e caracteres representando bytes usados e livres
@@ -206,6 +1439,11 @@ void displayContiguo(const vector<int>& disk, const unordered_map<string, File>&
 }
 
 void displayEncadeado(const vector<int>& disk, const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayEncadeado");
+    if (disk.size() > LIMITE_DESENHO_POR_BLOCO) {
+        displayMapaCompacto(disk, {&files}, 0, static_cast<int>(disk.size()) - 1, 0);
+        return;
+    }
     cout << "Memória Encadeada:" << endl;
     
     // map que associa cada bloco a uma tuple: (nome do arquivo, posição na cadeia, tamanho da cadeia, bytes usados)
@@ -294,6 +1532,11 @@ void displayEncadeado(const vector<int>& disk, const unordered_map<string, File>
 }
 
 void displayIndexado(const vector<int> &disk, const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayIndexado");
+    if (disk.size() > LIMITE_DESENHO_POR_BLOCO) {
+        displayMapaCompacto(disk, {&files}, 0, static_cast<int>(disk.size()) - 1, 0);
+        return;
+    }
     cout << "Memória Indexada:" << endl;
 
     // map que associa cada bloco a uma tuple: (nome do arquivo, tipo do bloco, bytes usados)
@@ -308,9 +1551,10 @@ void displayIndexado(const vector<int> &disk, const unordered_map<string, File>&
 
         // registra cada bloco de dados do arquivo
         int totalBlocks = static_cast<int>(file.dataBlocks.size());
+        int idx = -1;
         
-        for (int idx = 0; idx < totalBlocks; ++idx) {
-            int blk = file.dataBlocks[idx];
+        for (int blk : file.dataBlocks) {
+            ++idx;
             if (blk < 0 || blk >= static_cast<int>(disk.size()))
                 continue;
             int bytesUsed = TAMANHO_BLOCO;
@@ -350,10 +1594,7 @@ void displayIndexado(const vector<int> &disk, const unordered_map<string, File>&
         if (tipo == 1) { 
             // bloco índice → mostra os ponteiros para os blocos de dados
             cout << " → BLOCO ÍNDICE do " << file.name << " → [";
-            for (size_t j = 0; j < file.dataBlocks.size(); ++j) {
-                cout << file.dataBlocks[j];
-                if (j < file.dataBlocks.size() - 1) cout << ", ";
-            }
+            printListaBlocos(file.dataBlocks, ", ");
             cout << "]";
         } else {
             // bloco de dados → indica início, meio ou fim do arquivo
@@ -361,7 +1602,8 @@ void displayIndexado(const vector<int> &disk, const unordered_map<string, File>&
             if (totalBlocks == 1) {
                 cout << " → INICIO/FIM do " << file.name;
             } else {
-                int idx = find(file.dataBlocks.begin(), file.dataBlocks.end(), (int)i) - file.dataBlocks.begin();
+                int idx = 0;
+                for (auto it = file.dataBlocks.begin(); it != file.dataBlocks.end() && *it != (int)i; ++it) ++idx;
                 if (idx == 0) {
                     cout << " → INICIO do " << file.name;
                 } else if (idx == totalBlocks - 1) {
@@ -378,19 +1620,360 @@ void displayIndexado(const vector<int> &disk, const unordered_map<string, File>&
     printFreeBytesFooter(totalBytesLivres);
 }
 
-// criar arquivo para cada método de alocação
-void criarArquivoContiguo(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
-    // solicita nome e tamanho do arquivo (com validações comuns)
-    string fileName;
-    int tamanhoBytes;
-    int tamanhoBlocos;
+void displayExtents(const vector<int>& disk, const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayExtents");
+    if (disk.size() > LIMITE_DESENHO_POR_BLOCO) {
+        displayMapaCompacto(disk, {&files}, 0, static_cast<int>(disk.size()) - 1, 0);
+        return;
+    }
+    cout << "Memória por Extents:" << endl;
 
-    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
+    // map que associa cada bloco a uma tuple: (nome do arquivo, posição no arquivo, extent do bloco, bytes usados)
+    unordered_map<int, tuple<string, int, int, int>> blockInfo;
+
+    for (const auto &[nome, file] : files) {
+        int totalBlocks = file.size;
+        int pos = 0;
+        for (int e = 0; e < static_cast<int>(file.extents.size()); ++e) {
+            auto [inicio, tamanho] = file.extents[e];
+            for (int b = inicio; b < inicio + tamanho; ++b, ++pos) {
+                if (b < 0 || b >= static_cast<int>(disk.size()))
+                    continue;
+                blockInfo[b] = make_tuple(nome, pos, e, bytesUsedForBlock(file.sizeBytes, pos, totalBlocks));
+            }
+        }
+    }
+
+    int totalBytesLivres = 0;
+
+    for (size_t i = 0; i < disk.size(); ++i) {
+        auto itInfo = blockInfo.find(static_cast<int>(i));
+
+        if (itInfo == blockInfo.end()) {
+            // bloco livre ou desconhecido
+            if (disk[i] == BLOCO_LIVRE) {
+                printFreeBlock(i);
+                cout << endl;
+                totalBytesLivres += TAMANHO_BLOCO;
+            } else {
+                cout << "[" << i << "] █ → ?" << endl;
+            }
+            continue;
+        }
+
+        auto [nome, pos, extent, bytesUsed] = itInfo->second;
+        const File& file = files.at(nome);
+
+        printColoredBlockBar(i, file.color, bytesUsed);
+
+        if (file.size == 1) {
+            cout << " → INICIO/FIM do " << file.name;
+        } else if (pos == 0) {
+            cout << " → INICIO do " << file.name;
+        } else if (pos == file.size - 1) {
+            cout << " → FIM do " << file.name;
+        } else {
+            cout << " [" << file.name << "]";
+        }
+
+        // indica o início de cada extent do arquivo
+        if (static_cast<int>(i) == file.extents[extent].first) {
+            cout << " (extent " << extent + 1 << "/" << file.extents.size() << ")";
+        }
+        cout << endl;
+
+        totalBytesLivres += (TAMANHO_BLOCO - bytesUsed); // fragmentação interna
+    }
+
+    printFreeBytesFooter(totalBytesLivres);
+}
+
+// ---------------- redesenho incremental do disco ----------------
+// com o painel ativo, o disco fica fixo no topo do terminal e o menu rola numa região abaixo dele
+// (margens de rolagem do VT100). Cada criação ou extensão marca as faixas de blocos que mudaram (posição
+// antiga e nova do arquivo) e só essas linhas são repintadas com endereçamento do cursor. Quadros mais
+// próximos que 1/fps ficam acumulados e saem juntos no próximo quadro
+constexpr int LINHAS_RESERVADAS_MENU = 30; // menu e prompts, na região que rola abaixo do painel
+constexpr int MINIMO_LINHAS_PAINEL = 4;
+
+struct PainelDisco {
+    bool ativo = false;
+    bool valido = false;               // false: a tela não mostra o painel (primeiro quadro ou o disco mudou por fora)
+    int quadrosPorSegundo = 20;
+    int altura = 0;                    // linhas do terminal
+    int linhas = 0;                    // blocos visíveis no painel
+    int topo = 0;                      // primeiro bloco visível
+    map<int, int> faixasSujas;         // início -> fim (inclusive), faixas disjuntas e não adjacentes
+    vector<string> arquivosSujos;      // donos possíveis dos blocos sujos
+    bool quadroPendente = false;
+    chrono::steady_clock::time_point ultimoQuadro;
+    const vector<int>* disco = nullptr;
+    vector<const unordered_map<string, File>*> mapas;
+};
+
+PainelDisco painelDisco;
+
+int alturaDoTerminal() {
+#if SIMULADOR_COM_MMAP
+    winsize janela{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &janela) == 0 && janela.ws_row > 0) return janela.ws_row;
+#endif
+    if (const char* linhas = getenv("LINES")) {
+        int n = atoi(linhas);
+        if (n > 0) return n;
+    }
+    return 48;
+}
+
+bool saidaEhTerminal() {
+#if SIMULADOR_COM_MMAP
+    return isatty(STDOUT_FILENO);
+#else
+    return true;
+#endif
+}
+
+void marcarFaixaSuja(int inicio, int fim) {
+    auto& faixas = painelDisco.faixasSujas;
+    auto it = faixas.upper_bound(inicio);
+    if (it != faixas.begin() && prev(it)->second + 1 >= inicio) {
+        --it;
+        inicio = it->first;
+        fim = max(fim, it->second);
+        it = faixas.erase(it);
+    }
+    while (it != faixas.end() && it->first <= fim + 1) {
+        fim = max(fim, it->second);
+        it = faixas.erase(it);
+    }
+    faixas[inicio] = fim;
+}
+
+// marca os blocos atuais do arquivo; chamado antes (posição antiga) e depois (posição nova) da operação
+void marcarArquivoSujo(const unordered_map<string, File>& files, const string& nome) {
+    if (!painelDisco.ativo) return;
+    auto it = files.find(nome);
+    if (it == files.end()) return;
+    const File& file = it->second;
+    vector<int> blocos = blocosDoArquivo(file);
+    if (file.metodo == METODO_INDEXADO && file.indexBlock >= 0) blocos.push_back(file.indexBlock);
+    sort(blocos.begin(), blocos.end());
+    for (size_t i = 0, j; i < blocos.size(); i = j) {
+        for (j = i + 1; j < blocos.size() && blocos[j] == blocos[j - 1] + 1; ++j) {}
+        marcarFaixaSuja(blocos[i], blocos[j - 1]);
+    }
+    if (find(painelDisco.arquivosSujos.begin(), painelDisco.arquivosSujos.end(), nome) == painelDisco.arquivosSujos.end())
+        painelDisco.arquivosSujos.push_back(nome);
+}
+
+void invalidarPainel() {
+    painelDisco.valido = false;
+    painelDisco.quadroPendente = false;
+    painelDisco.faixasSujas.clear();
+    painelDisco.arquivosSujos.clear();
+}
+
+struct DonoBloco {
+    const File* file = nullptr;
+    int pos = 0;      // posição lógica no arquivo; -1 = bloco índice
+    int total = 0;    // blocos de dados do arquivo
+};
+
+// dono de cada bloco, olhando só os arquivos nomeados (ou todos, com nomes == nullptr)
+unordered_map<int, DonoBloco> donosDosBlocos(const vector<const unordered_map<string, File>*>& mapas,
+                                             const vector<string>* nomes) {
+    unordered_map<int, DonoBloco> donos;
+    auto registrar = [&donos](const File& file) {
+        vector<int> blocos = blocosDoArquivo(file);
+        int total = static_cast<int>(blocos.size());
+        for (int idx = 0; idx < total; ++idx) donos[blocos[idx]] = {&file, idx, total};
+        if (file.metodo == METODO_INDEXADO && file.indexBlock >= 0) donos[file.indexBlock] = {&file, -1, total};
+    };
+    for (const auto* files : mapas) {
+        if (nomes == nullptr) {
+            for (const auto& [nome, file] : *files) registrar(file);
+            continue;
+        }
+        for (const string& nome : *nomes) {
+            auto it = files->find(nome);
+            if (it != files->end()) registrar(it->second);
+        }
+    }
+    return donos;
+}
+
+// a mesma linha que os display* imprimem para o bloco (sem a quebra de linha)
+void printLinhaDoBloco(const vector<int>& disk, int i, const DonoBloco* dono, bool mostrarMetodo) {
+    if (dono == nullptr) {
+        if (disk[i] == BLOCO_LIVRE) printFreeBlock(i);
+        else cout << "[" << i << "] █ → ?";
         return;
     }
+    const File& file = *dono->file;
+    if (dono->pos == -1) {
+        printColoredBlockBar(i, file.color, TAMANHO_BLOCO);
+        cout << " → BLOCO ÍNDICE do " << file.name << " → [";
+        printListaBlocos(file.dataBlocks, ", ");
+        cout << "]";
+        if (mostrarMetodo) cout << " (" << nomeDoMetodo(file.metodo) << ")";
+        return;
+    }
+    printColoredBlockBar(i, file.color, bytesUsedForBlock(file.sizeBytes, dono->pos, dono->total));
+    bool encadeado = file.metodo == METODO_ENCADEADO;
+    if (dono->total == 1) cout << " → INICIO/FIM do " << file.name;
+    else if (dono->pos == 0) cout << " → INICIO do " << file.name;
+    else if (dono->pos == dono->total - 1) cout << " → FIM do " << file.name;
+    else if (!encadeado || mostrarMetodo) cout << " [" << file.name << "]";
+    if (encadeado && disk[i] != FIM_CADEIA) cout << " → [" << disk[i] << "]";
+    if (file.metodo == METODO_EXTENTS && !mostrarMetodo) {
+        for (size_t e = 0; e < file.extents.size(); ++e) {
+            if (file.extents[e].first == i) cout << " (extent " << e + 1 << "/" << file.extents.size() << ")";
+        }
+    }
+    if (mostrarMetodo) cout << " (" << nomeDoMetodo(file.metodo) << ")";
+}
+
+int bytesLivresDoDisco(const vector<int>& disk) {
+    if (const MetricasVolume* m = metricasDoDisco(disk))
+        return static_cast<int>(m->blocosLivres * TAMANHO_BLOCO + m->fragInterna);
+    return resumirEspacoLivre(disk).blocosLivres * TAMANHO_BLOCO;
+}
+
+void printRodapePainel(const vector<int>& disk) {
+    cout << "\033[" << painelDisco.linhas + 3 << ";1H\033[2K";
+    cout << "Total de bytes livres no disco: " << bytesLivresDoDisco(disk) << " bytes";
+}
+
+// limpa a tela, desenha o painel inteiro e prende a rolagem do terminal às linhas abaixo dele
+void desenharPainelCompleto(const vector<int>& disk, bool mostrarMetodo) {
+    PainelDisco& painel = painelDisco;
+    unordered_map<int, DonoBloco> donos = donosDosBlocos(painel.mapas, nullptr);
+    int fim = min(static_cast<int>(disk.size()), painel.topo + painel.linhas);
+    cout << "\033[r\033[2J\033[H\033[?7l"; // sem quebra automática: cada bloco ocupa uma linha da tela
+    cout << "Disco (blocos " << painel.topo << "-" << fim - 1 << " de " << disk.size() << "):";
+    for (int i = painel.topo; i < fim; ++i) {
+        auto it = donos.find(i);
+        cout << "\n";
+        printLinhaDoBloco(disk, i, it == donos.end() ? nullptr : &it->second, mostrarMetodo);
+    }
+    cout << "\033[" << painel.linhas + 2 << ";1H---------------------------------------------------------";
+    printRodapePainel(disk);
+    cout << "\033[?7h\033[" << painel.linhas + 4 << ";" << painel.altura << "r\033[" << painel.altura << ";1H" << flush;
+}
+
+// repinta só as linhas das faixas sujas que estão no painel; se nenhuma está visível, o painel rola até a primeira
+void desenharQuadro() {
+    PainelDisco& painel = painelDisco;
+    const vector<int>& disk = *painel.disco;
+    bool mostrarMetodo = painel.mapas.size() > 1;
+    int fimJanela = painel.topo + painel.linhas - 1;
+    bool visivel = false;
+    for (const auto& [inicio, fim] : painel.faixasSujas) visivel = visivel || (inicio <= fimJanela && fim >= painel.topo);
+    if (!painel.faixasSujas.empty() && !visivel) {
+        int maximoTopo = max(0, static_cast<int>(disk.size()) - painel.linhas);
+        painel.topo = min(maximoTopo, max(0, painel.faixasSujas.begin()->first - painel.linhas / 4));
+        desenharPainelCompleto(disk, mostrarMetodo);
+    } else {
+        unordered_map<int, DonoBloco> donos = donosDosBlocos(painel.mapas, &painel.arquivosSujos);
+        cout << "\0337\033[?7l"; // guarda o cursor do menu
+        for (const auto& [inicio, fim] : painel.faixasSujas) {
+            for (int i = max(inicio, painel.topo); i <= min(fim, fimJanela); ++i) {
+                cout << "\033[" << 2 + i - painel.topo << ";1H\033[2K";
+                auto it = donos.find(i);
+                printLinhaDoBloco(disk, i, it == donos.end() ? nullptr : &it->second, mostrarMetodo);
+            }
+        }
+        printRodapePainel(disk);
+        cout << "\033[?7h\0338" << flush;
+    }
+    painel.faixasSujas.clear();
+    painel.arquivosSujos.clear();
+    painel.quadroPendente = false;
+    painel.ultimoQuadro = chrono::steady_clock::now();
+}
+
+// devolve false com o painel desligado (ou sem espaço na tela): o chamador mostra o disco inteiro como antes
+bool redesenharAlteracoes(const vector<int>& disk, initializer_list<const unordered_map<string, File>*> mapas) {
+    EscopoRastro rastro("redesenharAlteracoes");
+    PainelDisco& painel = painelDisco;
+    if (!painel.ativo || disk.size() > LIMITE_DESENHO_POR_BLOCO) {
+        invalidarPainel();
+        return false;
+    }
+    painel.disco = &disk;
+    painel.mapas.assign(mapas.begin(), mapas.end());
+    if (!painel.valido) {
+        painel.altura = alturaDoTerminal();
+        painel.linhas = min(static_cast<int>(disk.size()), painel.altura - LINHAS_RESERVADAS_MENU);
+        if (painel.linhas < MINIMO_LINHAS_PAINEL) {
+            invalidarPainel();
+            return false;
+        }
+        painel.topo = 0;
+        desenharPainelCompleto(disk, painel.mapas.size() > 1);
+        invalidarPainel();
+        painel.valido = true;
+        painel.ultimoQuadro = chrono::steady_clock::now();
+        return true;
+    }
+    auto intervalo = chrono::milliseconds(1000 / painel.quadrosPorSegundo);
+    if (chrono::steady_clock::now() - painel.ultimoQuadro < intervalo) {
+        painel.quadroPendente = true; // sai no próximo quadro ou antes de esperar a próxima opção
+        return true;
+    }
+    desenharQuadro();
+    return true;
+}
+
+// antes de bloquear esperando o usuário, nada pode ficar só no quadro acumulado
+void apresentarQuadroPendente() {
+    if (painelDisco.ativo && painelDisco.valido && painelDisco.quadroPendente) desenharQuadro();
+}
+
+void encerrarPainel() {
+    if (painelDisco.ativo && painelDisco.valido) cout << "\033[r\033[2J\033[H" << flush;
+    invalidarPainel();
+}
 
-    bool allocated = false;
+void painelIncrementalMenu() {
+    char resposta;
+    cout << "Manter o disco fixo no topo do terminal e redesenhar só os blocos alterados? (s/n): ";
+    cin >> resposta;
+    if (resposta != 's' && resposta != 'S') {
+        encerrarPainel();
+        painelDisco.ativo = false;
+        cout << "Redesenho incremental desativado: cada operação mostra o disco inteiro." << endl;
+        return;
+    }
+    if (!saidaEhTerminal()) {
+        cout << "A saída não é um terminal: o redesenho incremental precisa de endereçamento do cursor." << endl;
+        return;
+    }
+    int quadros;
+    cout << "Quadros por segundo (1 a 60): ";
+    cin >> quadros;
+    if (cin.fail() || quadros < 1 || quadros > 60) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Valor inválido!" << endl;
+        return;
+    }
+    painelDisco.quadrosPorSegundo = quadros;
+    painelDisco.ativo = true;
+    invalidarPainel();
+    cout << "Redesenho incremental ativo: o painel aparece na próxima criação ou extensão";
+    if (alturaDoTerminal() - LINHAS_RESERVADAS_MENU < MINIMO_LINHAS_PAINEL)
+        cout << " (o terminal precisa de pelo menos " << LINHAS_RESERVADAS_MENU + MINIMO_LINHAS_PAINEL << " linhas)";
+    cout << "." << endl;
+}
 
+// alocação sem interação para cada método (usada pelos menus e pelo modo misto)
+ResultadoAlocacao alocarArquivoContiguo(vector<int>& disk,
+                                        unordered_map<string, File>& files,
+                                        unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                        const string& fileName, int tamanhoBytes, int tamanhoBlocos,
+                                        int& fileID) {
+    EscopoRastro rastro("alocarArquivoContiguo");
     // busca por espaço contíguo livre no disco
     for (int i = 0; i <= static_cast<int>(disk.size()) - tamanhoBlocos; ++i) {
         bool canAllocate = true;
@@ -411,6 +1994,7 @@ void criarArquivoContiguo(vector<int>& disk, unordered_map<string, File>& files,
             newFile.name = fileName;
             newFile.color = getFileColor(fileID++); // obtém uma cor para o arquivo
             newFile.sizeBytes = tamanhoBytes;
+            newFile.metodo = METODO_CONTIGUO;
             // marca os blocos no disco como ocupados pelo arquivo
             for (int j = 0; j < tamanhoBlocos; ++j) {
                 disk[i + j] = i;
@@ -418,39 +2002,29 @@ void criarArquivoContiguo(vector<int>& disk, unordered_map<string, File>& files,
 
             // adiciona o arquivo ao map de arquivos files
             files[fileName] = newFile;
+            metricasArquivoCriado(disk, newFile);
             
             tabelaDiretorio[fileName] = make_tuple(i, tamanhoBlocos); // atualiza a tabela de diretório
-
-            cout << "Arquivo criado com sucesso!" << endl;
-            displayContiguo(disk, files); // mostra o disco atualizado
-            allocated = true;
-            break;
+            return ALOCACAO_OK;
         }
     }
     
-    // caso não tenha espaço contíguo suficiente, informa erro
-    if (!allocated) {
-        cout << "Erro: Espaço insuficiente no disco!" << endl;
-    }
+    // não há espaço contíguo suficiente
+    return falhaAlocacao(disk, ERRO_ESPACO_INSUFICIENTE, tamanhoBlocos);
 }
 
-void criarArquivoEncadeado(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
-    // solicita nome e tamanho do arquivo (com validações comuns)
-    string fileName;
-    int tamanhoBytes;
-    int tamanhoBlocos;
-
-    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
-        return;
-    }
-
+ResultadoAlocacao alocarArquivoEncadeado(vector<int>& disk,
+                                         unordered_map<string, File>& files,
+                                         unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                         const string& fileName, int tamanhoBytes, int tamanhoBlocos,
+                                         int& fileID) {
+    EscopoRastro rastro("alocarArquivoEncadeado");
     // busca blocos livres no disco
     vector<int> freeBlocks = collectFreeBlocks(disk);
     
     // verifica se há blocos livres suficientes
-    if (freeBlocks.size() < static_cast<size_t>(tamanhoBlocos)) {
-        cout << "Erro: Espaço insuficiente no disco!" << endl;
-        return;
+    if (tamanhoBlocos <= 0 || freeBlocks.size() < static_cast<size_t>(tamanhoBlocos)) {
+        return falhaAlocacao(disk, ERRO_ESPACO_INSUFICIENTE, tamanhoBlocos);
     }
 
     // embaralha os blocos livres para distribuir aleatoriamente
@@ -476,34 +2050,30 @@ void criarArquivoEncadeado(vector<int>& disk, unordered_map<string, File>& files
     // cria e inicializa o arquivo
     File newFile;
     newFile.startBlock = dataBlocks[0];
-    newFile.dataBlocks = dataBlocks;
+    newFile.dataBlocks.assign(dataBlocks.begin(), dataBlocks.end());
     newFile.size = tamanhoBlocos;
     newFile.name = fileName;
     newFile.color = color;
     newFile.sizeBytes = tamanhoBytes;
+    newFile.metodo = METODO_ENCADEADO;
 
     tabelaDiretorio[fileName] = make_tuple(dataBlocks[0], tamanhoBlocos); // atualiza a tabela de diretório
 
     // adiciona o arquivo ao map de arquivos files
     files[fileName] = newFile;
-
-    cout << "Arquivo criado com sucesso!" << endl;
-    displayEncadeado(disk, files); // mostra o disco atualizado
+    metricasArquivoCriado(disk, newFile);
+    return ALOCACAO_OK;
 }
 
-void criarArquivoIndexado(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
-    string fileName;
-    int tamanhoBytes;
-    int tamanhoBlocos;
-
-    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
-        return;
-    }
-
+ResultadoAlocacao alocarArquivoIndexado(vector<int>& disk,
+                                        unordered_map<string, File>& files,
+                                        unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                        const string& fileName, int tamanhoBytes, int tamanhoBlocos,
+                                        int& fileID) {
+    EscopoRastro rastro("alocarArquivoIndexado");
     // verifica o bloco índice (suporta no máximo 8 blocos de dados/endereços)
-    if (tamanhoBlocos > 8) {
-        cout << "Erro: O bloco de índice só pode armazenar até 8 endereços de blocos de dados!" << endl;
-        return;
+    if (tamanhoBlocos > MAX_ENTRADAS_INDICE) {
+        return falhaAlocacao(disk, ERRO_INDICE_CHEIO, tamanhoBlocos + 1);
     }
 
     // busca blocos livres no disco
@@ -511,8 +2081,7 @@ void criarArquivoIndexado(vector<int>& disk, unordered_map<string, File>& files,
 
     // verifica se há blocos livres suficientes, incluindo o bloco índice
     if (freeBlocks.size() < static_cast<size_t>(tamanhoBlocos + 1)) {
-        cout << "Erro: Espaço insuficiente no disco!" << endl;
-        return;
+        return falhaAlocacao(disk, ERRO_ESPACO_INSUFICIENTE, tamanhoBlocos + 1);
     }
 
     // embaralha os blocos livres para distribuir aleatoriamente (blocos podem estar espalhados pelo disco)
@@ -527,6 +2096,7 @@ void criarArquivoIndexado(vector<int>& disk, unordered_map<string, File>& files,
     newFile.indexBlock = indexBlock;
     newFile.name = fileName;
     newFile.size = tamanhoBlocos;
+    newFile.metodo = METODO_INDEXADO;
     
     newFile.color = getFileColor(fileID++); // obtém uma cor para o arquivo
     newFile.sizeBytes = tamanhoBytes;
@@ -540,50 +2110,575 @@ void criarArquivoIndexado(vector<int>& disk, unordered_map<string, File>& files,
 
     // adiciona o arquivo ao map de arquivos files
     files[fileName] = newFile;
+    metricasArquivoCriado(disk, newFile);
     tabelaDiretorio[fileName] = make_tuple(indexBlock, tamanhoBlocos); // atualiza a tabela de diretório
-
-    cout << "Arquivo criado com sucesso!" << endl;
-    displayIndexado(disk, files); // mostra o disco atualizado
+    return ALOCACAO_OK;
 }
 
-void deleteArquivo(vector<int>& disk,
-                   unordered_map<string, File>& filesContiguous, 
-                   unordered_map<string, File>& filesEncadeados, 
-                   unordered_map<string, File>& filesIndexados) {
-    // solicita o nome do arquivo a ser deletado
-    string fileName;
-    cout << "Digite o nome do arquivo a ser deletado: ";
-    cin >> fileName;
-
-    // verifica se o arquivo é do tipo contíguo
-    if (filesContiguous.find(fileName) != filesContiguous.end()) {
-        File file = filesContiguous[fileName];
-        // libera os blocos ocupados pelo arquivo no disco
-        for (int i = file.startBlock; i < file.startBlock + file.size; ++i) {
-            disk[i] = -1;
+// escolhe trechos livres para os blocos pedidos: os maiores trechos primeiro e, para o restante,
+// o menor trecho que o comporte (preserva os trechos grandes). Falha se precisar de mais que maxExtents
+bool escolherExtents(const vector<int>& disk, int blocos, int maxExtents, vector<pair<int,int>>& extentsOut) {
+    vector<pair<int,int>> trechos = listarTrechosLivres(disk);
+    stable_sort(trechos.begin(), trechos.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    extentsOut.clear();
+    int restante = blocos;
+    size_t proximo = 0;
+    while (restante > 0) {
+        if (static_cast<int>(extentsOut.size()) >= maxExtents || proximo >= trechos.size()) {
+            return false;
         }
-        
-        // remove o arquivo do map filesContiguos
-        filesContiguous.erase(fileName);
-        tabelaDiretorio.erase(fileName);
 
-        cout << "Arquivo " << fileName << " deletado com sucesso!" << endl;
-    } // verifica se o arquivo é do tipo encadeado
-      else if (filesEncadeados.find(fileName) != filesEncadeados.end()) {
-        File file = filesEncadeados[fileName];
-        // libera os blocos ocupados pelo arquivo no disco
-        for (int block : file.dataBlocks) {
-            disk[block] = -1;
+        // menor trecho (ainda não usado) que comporta todo o restante
+        size_t melhor = trechos.size();
+        for (size_t t = proximo; t < trechos.size() && trechos[t].second >= restante; ++t) {
+            melhor = t;
+        }
+        if (melhor != trechos.size()) {
+            extentsOut.push_back({trechos[melhor].first, restante});
+            return true;
         }
-        
-        disk[file.startBlock] = -1; 
-        
-        // remove o arquivo do map filesEncadeados e tabela de diretório
-        filesEncadeados.erase(fileName);
-        tabelaDiretorio.erase(fileName);
 
-        cout << "Arquivo " << fileName << " deletado com sucesso!" << endl;
-    } // verifica se o arquivo é do tipo indexado
+        // nenhum trecho comporta o restante: usa o maior trecho inteiro
+        extentsOut.push_back(trechos[proximo]);
+        restante -= trechos[proximo].second;
+        ++proximo;
+    }
+    return true;
+}
+
+// junta extents consecutivos que são fisicamente adjacentes
+void mesclarExtents(vector<pair<int,int>>& extents) {
+    vector<pair<int,int>> mesclados;
+    for (const auto& extent : extents) {
+        if (!mesclados.empty() && mesclados.back().first + mesclados.back().second == extent.first) {
+            mesclados.back().second += extent.second;
+        } else {
+            mesclados.push_back(extent);
+        }
+    }
+    extents = mesclados;
+}
+
+ResultadoAlocacao alocarArquivoExtents(vector<int>& disk,
+                                       unordered_map<string, File>& files,
+                                       unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                       const string& fileName, int tamanhoBytes, int tamanhoBlocos,
+                                       int& fileID) {
+    EscopoRastro rastro("alocarArquivoExtents");
+    vector<pair<int,int>> extents;
+    if (!escolherExtents(disk, tamanhoBlocos, MAX_EXTENTS, extents)) {
+        // distingue disco cheio de espaço livre fragmentado demais
+        return falhaAlocacao(disk, resumirEspacoLivre(disk).blocosLivres < tamanhoBlocos
+                                       ? ERRO_ESPACO_INSUFICIENTE : ERRO_LIMITE_EXTENTS, tamanhoBlocos);
+    }
+
+    // cria e inicializa o arquivo
+    File newFile;
+    newFile.startBlock = extents[0].first;
+    newFile.extents = extents;
+    newFile.size = tamanhoBlocos;
+    newFile.name = fileName;
+    newFile.color = getFileColor(fileID++); // obtém uma cor para o arquivo
+    newFile.sizeBytes = tamanhoBytes;
+    newFile.metodo = METODO_EXTENTS;
+
+    // marca os blocos de todos os extents como ocupados pelo arquivo (mesma marcação da contígua)
+    for (const auto& [inicio, tamanho] : extents) {
+        for (int b = inicio; b < inicio + tamanho; ++b) {
+            disk[b] = newFile.startBlock;
+        }
+    }
+
+    files[fileName] = newFile;
+    metricasArquivoCriado(disk, newFile);
+    tabelaDiretorio[fileName] = make_tuple(newFile.startBlock, tamanhoBlocos); // atualiza a tabela de diretório
+    return ALOCACAO_OK;
+}
+
+void imprimirErroAlocacao(ResultadoAlocacao resultado) {
+    switch (resultado) {
+        case ERRO_ESPACO_INSUFICIENTE:
+            cout << "Erro: Espaço insuficiente no disco!" << endl;
+            imprimirUltimoDiagnostico();
+            break;
+        case ERRO_SEM_ESPACO_CONTIGUO:
+            cout << "Erro: Não há espaço contíguo disponível para extensão!" << endl;
+            imprimirUltimoDiagnostico();
+            break;
+        case ERRO_INDICE_CHEIO:
+            cout << "Erro: O bloco de índice só pode armazenar até " << MAX_ENTRADAS_INDICE
+                 << " endereços de blocos de dados!" << endl;
+            break;
+        case ERRO_LIMITE_EXTENTS:
+            cout << "Erro: Espaço livre fragmentado demais (limite de " << MAX_EXTENTS
+                 << " extents por arquivo)!" << endl;
+            imprimirUltimoDiagnostico();
+            break;
+        case ERRO_ARQUIVO_EXISTENTE:
+            cout << "Erro: Já existe um arquivo com esse nome!" << endl;
+            break;
+        case ERRO_ARQUIVO_INEXISTENTE:
+            cout << "Erro: Arquivo não encontrado!" << endl;
+            break;
+        default:
+            break;
+    }
+}
+
+// criar arquivo para cada método de alocação
+void criarArquivoContiguo(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
+    // solicita nome e tamanho do arquivo (com validações comuns)
+    string fileName;
+    int tamanhoBytes;
+    int tamanhoBlocos;
+
+    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
+        return;
+    }
+
+    ResultadoAlocacao resultado = alocarArquivoContiguo(disk, files, tabelaDiretorio,
+                                                        fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo criado com sucesso!" << endl;
+    marcarArquivoSujo(files, fileName);
+    if (!redesenharAlteracoes(disk, {&files})) {
+        displayContiguo(disk, files); // mostra o disco atualizado
+    }
+}
+
+void criarArquivoEncadeado(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
+    // solicita nome e tamanho do arquivo (com validações comuns)
+    string fileName;
+    int tamanhoBytes;
+    int tamanhoBlocos;
+
+    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
+        return;
+    }
+
+    ResultadoAlocacao resultado = alocarArquivoEncadeado(disk, files, tabelaDiretorio,
+                                                         fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo criado com sucesso!" << endl;
+    marcarArquivoSujo(files, fileName);
+    if (!redesenharAlteracoes(disk, {&files})) {
+        displayEncadeado(disk, files); // mostra o disco atualizado
+    }
+}
+
+void criarArquivoIndexado(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
+    string fileName;
+    int tamanhoBytes;
+    int tamanhoBlocos;
+
+    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
+        return;
+    }
+
+    ResultadoAlocacao resultado = alocarArquivoIndexado(disk, files, tabelaDiretorio,
+                                                        fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo criado com sucesso!" << endl;
+    marcarArquivoSujo(files, fileName);
+    if (!redesenharAlteracoes(disk, {&files})) {
+        displayIndexado(disk, files); // mostra o disco atualizado
+    }
+}
+
+void criarArquivoExtents(vector<int>& disk, unordered_map<string, File>& files, int& fileID) {
+    string fileName;
+    int tamanhoBytes;
+    int tamanhoBlocos;
+
+    if (!promptCreateCommon(files, disk,  fileName, tamanhoBytes, tamanhoBlocos)) {
+        return;
+    }
+
+    ResultadoAlocacao resultado = alocarArquivoExtents(disk, files, tabelaDiretorio,
+                                                       fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo criado com sucesso!" << endl;
+    marcarArquivoSujo(files, fileName);
+    if (!redesenharAlteracoes(disk, {&files})) {
+        displayExtents(disk, files); // mostra o disco atualizado
+    }
+}
+
+// retorna o map que contém o arquivo (ou nullptr se não existir em nenhum método)
+unordered_map<string, File>* buscarMapaDoArquivo(const string& fileName,
+                                                 unordered_map<string, File>& filesContiguous,
+                                                 unordered_map<string, File>& filesEncadeados,
+                                                 unordered_map<string, File>& filesIndexados,
+                                                 unordered_map<string, File>& filesExtents) {
+    if (filesContiguous.count(fileName)) return &filesContiguous;
+    if (filesEncadeados.count(fileName)) return &filesEncadeados;
+    if (filesIndexados.count(fileName)) return &filesIndexados;
+    if (filesExtents.count(fileName)) return &filesExtents;
+    return nullptr;
+}
+
+// modelo de tempo do dispositivo: fonte única dos custos usados pelas leituras simuladas e pelo
+// relógio virtual (antes cada função trazia as próprias constantes nos parâmetros padrão)
+struct ModeloTempo {
+    int sequencial = 1; // ms por bloco fisicamente seguinte ao último atendido
+    int aleatorio = 5;  // ms por bloco que exige posicionamento
+    int indice = 5;     // ms para ler o bloco índice
+    int metadado = 5;   // ms por escrita de metadados (entrada de diretório, mapa de livres, ponteiro, índice)
+    int barreira = 5;   // ms de um flush (barreira) do dispositivo, usado pelo journal
+};
+
+ModeloTempo modeloTempo;
+
+// cache de blocos (page cache) na frente das leituras simuladas
+constexpr int CACHE_DESATIVADO = 0;
+constexpr int CACHE_LRU = 1;
+constexpr int CACHE_CLOCK = 2;
+constexpr int CACHE_2Q = 3;
+constexpr int CACHE_ARC = 4;
+constexpr double T_CACHE = 0.1; // ms por acerto no cache
+
+// lista ordenada por recência (frente = mais recente) com busca O(1)
+struct ListaLRU {
+    list<int> ordem;
+    unordered_map<int, list<int>::iterator> posicao;
+};
+
+bool lruContem(const ListaLRU& lista, int bloco) {
+    return lista.posicao.count(bloco) > 0;
+}
+
+void lruInserir(ListaLRU& lista, int bloco) {
+    lista.ordem.push_front(bloco);
+    lista.posicao[bloco] = lista.ordem.begin();
+}
+
+void lruRemover(ListaLRU& lista, int bloco) {
+    auto it = lista.posicao.find(bloco);
+    if (it == lista.posicao.end()) return;
+    lista.ordem.erase(it->second);
+    lista.posicao.erase(it);
+}
+
+void lruTocar(ListaLRU& lista, int bloco) {
+    lista.ordem.splice(lista.ordem.begin(), lista.ordem, lista.posicao[bloco]);
+}
+
+int lruRemoverMaisAntigo(ListaLRU& lista) {
+    int bloco = lista.ordem.back();
+    lruRemover(lista, bloco);
+    return bloco;
+}
+
+struct CacheBlocos {
+    int politica = CACHE_DESATIVADO;
+    int capacidade = 16; // em blocos
+    ListaLRU lru;              // LRU e fila Am do 2Q
+    ListaLRU a1in, a1out;      // 2Q: fila FIFO de entrada e fantasmas
+    ListaLRU t1, t2, b1, b2;   // ARC: recentes, frequentes e seus fantasmas
+    double p = 0;              // ARC: tamanho alvo de t1
+    vector<int> quadros;                  // CLOCK: bloco em cada quadro
+    vector<bool> referencia;              // CLOCK: bit de referência
+    unordered_map<int, int> quadroDoBloco;
+    size_t ponteiro = 0;
+    long long acertos = 0;
+    long long faltas = 0;
+};
+
+CacheBlocos cacheBlocos;
+
+string nomeDaPolitica(int politica) {
+    switch (politica) {
+        case CACHE_LRU: return "LRU";
+        case CACHE_CLOCK: return "CLOCK";
+        case CACHE_2Q: return "2Q";
+        case CACHE_ARC: return "ARC";
+        default: return "desativado";
+    }
+}
+
+void configurarCache(CacheBlocos& cache, int politica, int capacidade) {
+    cache = CacheBlocos();
+    cache.politica = politica;
+    cache.capacidade = max(1, capacidade);
+}
+
+bool acessarCacheLRU(CacheBlocos& cache, int bloco) {
+    if (lruContem(cache.lru, bloco)) {
+        lruTocar(cache.lru, bloco);
+        return true;
+    }
+    if ((int)cache.lru.ordem.size() >= cache.capacidade) lruRemoverMaisAntigo(cache.lru);
+    lruInserir(cache.lru, bloco);
+    return false;
+}
+
+bool acessarCacheClock(CacheBlocos& cache, int bloco) {
+    auto it = cache.quadroDoBloco.find(bloco);
+    if (it != cache.quadroDoBloco.end()) {
+        cache.referencia[it->second] = true;
+        return true;
+    }
+
+    if ((int)cache.quadros.size() < cache.capacidade) {
+        cache.quadroDoBloco[bloco] = (int)cache.quadros.size();
+        cache.quadros.push_back(bloco);
+        cache.referencia.push_back(true);
+        return false;
+    }
+
+    // o ponteiro avança dando uma segunda chance aos quadros referenciados
+    while (cache.referencia[cache.ponteiro]) {
+        cache.referencia[cache.ponteiro] = false;
+        cache.ponteiro = (cache.ponteiro + 1) % cache.quadros.size();
+    }
+    cache.quadroDoBloco.erase(cache.quadros[cache.ponteiro]);
+    cache.quadros[cache.ponteiro] = bloco;
+    cache.referencia[cache.ponteiro] = true;
+    cache.quadroDoBloco[bloco] = (int)cache.ponteiro;
+    cache.ponteiro = (cache.ponteiro + 1) % cache.quadros.size();
+    return false;
+}
+
+// 2Q completo: a1in (FIFO dos blocos vistos uma vez), a1out (fantasmas) e Am (LRU dos reacessados)
+bool acessarCache2Q(CacheBlocos& cache, int bloco) {
+    int kin = max(1, cache.capacidade / 4);
+    int kout = max(1, cache.capacidade / 2);
+
+    if (lruContem(cache.lru, bloco)) {
+        lruTocar(cache.lru, bloco);
+        return true;
+    }
+    if (lruContem(cache.a1in, bloco)) {
+        return true;
+    }
+
+    // abre espaço para o novo bloco
+    if ((int)(cache.a1in.ordem.size() + cache.lru.ordem.size()) >= cache.capacidade) {
+        if ((int)cache.a1in.ordem.size() > kin || cache.lru.ordem.empty()) {
+            lruInserir(cache.a1out, lruRemoverMaisAntigo(cache.a1in));
+            if ((int)cache.a1out.ordem.size() > kout) lruRemoverMaisAntigo(cache.a1out);
+        } else {
+            lruRemoverMaisAntigo(cache.lru);
+        }
+    }
+
+    if (lruContem(cache.a1out, bloco)) {
+        lruRemover(cache.a1out, bloco);
+        lruInserir(cache.lru, bloco);
+    } else {
+        lruInserir(cache.a1in, bloco);
+    }
+    return false;
+}
+
+void substituirARC(CacheBlocos& cache, bool emB2) {
+    // só substitui com o cache cheio (invalidações podem deixar quadros vagos)
+    if ((int)(cache.t1.ordem.size() + cache.t2.ordem.size()) < cache.capacidade) return;
+
+    int tamanhoT1 = (int)cache.t1.ordem.size();
+    if (tamanhoT1 >= 1 && ((emB2 && tamanhoT1 == (int)cache.p) || tamanhoT1 > cache.p)) {
+        lruInserir(cache.b1, lruRemoverMaisAntigo(cache.t1));
+    } else if (!cache.t2.ordem.empty()) {
+        lruInserir(cache.b2, lruRemoverMaisAntigo(cache.t2));
+    } else {
+        lruInserir(cache.b1, lruRemoverMaisAntigo(cache.t1));
+    }
+}
+
+// ARC (Megiddo & Modha): adapta p entre recência (t1) e frequência (t2) pelos acertos fantasmas
+bool acessarCacheARC(CacheBlocos& cache, int bloco) {
+    int c = cache.capacidade;
+
+    if (lruContem(cache.t1, bloco)) {
+        lruRemover(cache.t1, bloco);
+        lruInserir(cache.t2, bloco);
+        return true;
+    }
+    if (lruContem(cache.t2, bloco)) {
+        lruTocar(cache.t2, bloco);
+        return true;
+    }
+
+    if (lruContem(cache.b1, bloco)) {
+        double delta = max(1.0, (double)cache.b2.ordem.size() / cache.b1.ordem.size());
+        cache.p = min((double)c, cache.p + delta);
+        substituirARC(cache, false);
+        lruRemover(cache.b1, bloco);
+        lruInserir(cache.t2, bloco);
+        return false;
+    }
+    if (lruContem(cache.b2, bloco)) {
+        double delta = max(1.0, (double)cache.b1.ordem.size() / cache.b2.ordem.size());
+        cache.p = max(0.0, cache.p - delta);
+        substituirARC(cache, true);
+        lruRemover(cache.b2, bloco);
+        lruInserir(cache.t2, bloco);
+        return false;
+    }
+
+    int l1 = (int)(cache.t1.ordem.size() + cache.b1.ordem.size());
+    int total = l1 + (int)(cache.t2.ordem.size() + cache.b2.ordem.size());
+    if (l1 == c) {
+        if ((int)cache.t1.ordem.size() < c) {
+            lruRemoverMaisAntigo(cache.b1);
+            substituirARC(cache, false);
+        } else {
+            lruRemoverMaisAntigo(cache.t1);
+        }
+    } else if (total >= c) {
+        if (total == 2 * c) lruRemoverMaisAntigo(cache.b2);
+        substituirARC(cache, false);
+    }
+    lruInserir(cache.t1, bloco);
+    return false;
+}
+
+// acessa um bloco pelo cache; retorna true em caso de acerto
+bool acessarCache(CacheBlocos& cache, int bloco) {
+    bool acerto = false;
+    switch (cache.politica) {
+        case CACHE_LRU: acerto = acessarCacheLRU(cache, bloco); break;
+        case CACHE_CLOCK: acerto = acessarCacheClock(cache, bloco); break;
+        case CACHE_2Q: acerto = acessarCache2Q(cache, bloco); break;
+        case CACHE_ARC: acerto = acessarCacheARC(cache, bloco); break;
+        default: return false;
+    }
+    if (acerto) ++cache.acertos; else ++cache.faltas;
+    return acerto;
+}
+
+// remove um bloco liberado do cache (o número do bloco pode ser reaproveitado por outro arquivo)
+void invalidarBlocoCache(CacheBlocos& cache, int bloco) {
+    for (ListaLRU* lista : {&cache.lru, &cache.a1in, &cache.a1out, &cache.t1, &cache.t2, &cache.b1, &cache.b2}) {
+        lruRemover(*lista, bloco);
+    }
+    auto it = cache.quadroDoBloco.find(bloco);
+    if (it != cache.quadroDoBloco.end()) {
+        cache.referencia[it->second] = false;
+        cache.quadros[it->second] = BLOCO_LIVRE;
+        cache.quadroDoBloco.erase(it);
+    }
+}
+
+// passa os acessos (bloco, custo no dispositivo em ms) de uma leitura pelo cache e mostra o tempo efetivo
+void lerComCache(const vector<pair<int,int>>& acessos, const string& rotulo) {
+    if (cacheBlocos.politica == CACHE_DESATIVADO || acessos.empty()) return;
+
+    int acertos = 0;
+    int tempoDispositivo = 0;
+    double tempoEfetivo = 0;
+    for (const auto& [bloco, custo] : acessos) {
+        tempoDispositivo += custo;
+        if (acessarCache(cacheBlocos, bloco)) {
+            ++acertos;
+            tempoEfetivo += T_CACHE;
+        } else {
+            tempoEfetivo += custo;
+        }
+    }
+
+    cout << rotulo << " com cache " << nomeDaPolitica(cacheBlocos.politica) << " (" << cacheBlocos.capacidade
+         << " blocos): " << acertos << "/" << acessos.size() << " acertos | "
+         << fixed << setprecision(1) << tempoEfetivo << " ms (sem cache " << tempoDispositivo << " ms)\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+void displayEstatisticasCache(const CacheBlocos& cache) {
+    long long total = cache.acertos + cache.faltas;
+    double taxa = total ? (double)cache.acertos / total : 0.0;
+    // latência efetiva média: acertos custam T_CACHE; faltas usam o custo de um bloco sequencial do modelo de tempo
+    double latencia = taxa * T_CACHE + (1 - taxa) * modeloTempo.sequencial;
+    cout << "Cache " << nomeDaPolitica(cache.politica) << " (" << cache.capacidade << " blocos): "
+         << cache.acertos << " acertos | " << cache.faltas << " faltas | taxa de acerto "
+         << fixed << setprecision(1) << taxa * 100 << "% | latência efetiva média "
+         << setprecision(2) << latencia << " ms/bloco\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+void configurarCacheMenu() {
+    displayEstatisticasCache(cacheBlocos);
+
+    int politica, capacidade;
+    cout << "Política do cache:\n0. Desativado\n1. LRU\n2. CLOCK\n3. 2Q\n4. ARC\n";
+    cin >> politica;
+    if (cin.fail() || politica < 0 || politica > 4) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Opção inválida!" << endl;
+        return;
+    }
+    if (politica == CACHE_DESATIVADO) {
+        configurarCache(cacheBlocos, CACHE_DESATIVADO, 0);
+        cout << "Cache desativado." << endl;
+        return;
+    }
+
+    cout << "Capacidade do cache (em blocos): ";
+    cin >> capacidade;
+    if (cin.fail() || capacidade <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Capacidade inválida!" << endl;
+        return;
+    }
+    configurarCache(cacheBlocos, politica, capacidade);
+    cout << "Cache " << nomeDaPolitica(politica) << " com " << capacidade << " blocos ativado." << endl;
+}
+
+// remoção sem interação: libera os blocos do arquivo em qualquer método (false se não existir)
+bool removerArquivo(vector<int>& disk,
+                    unordered_map<string, File>& filesContiguous,
+                    unordered_map<string, File>& filesEncadeados,
+                    unordered_map<string, File>& filesIndexados,
+                    unordered_map<string, File>& filesExtents,
+                    unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                    const string& fileName) {
+    if (auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents)) {
+        metricasArquivoRemovido(disk, files->at(fileName));
+    }
+
+    // verifica se o arquivo é do tipo contíguo
+    if (filesContiguous.find(fileName) != filesContiguous.end()) {
+        File file = filesContiguous[fileName];
+        // libera os blocos ocupados pelo arquivo no disco
+        for (int i = file.startBlock; i < file.startBlock + file.size; ++i) {
+            disk[i] = -1;
+        }
+        
+        // remove o arquivo do map filesContiguos
+        filesContiguous.erase(fileName);
+    } // verifica se o arquivo é do tipo encadeado
+      else if (filesEncadeados.find(fileName) != filesEncadeados.end()) {
+        File file = filesEncadeados[fileName];
+        // libera os blocos ocupados pelo arquivo no disco
+        for (int block : file.dataBlocks) {
+            disk[block] = -1;
+        }
+        
+        disk[file.startBlock] = -1; 
+        
+        // remove o arquivo do map filesEncadeados
+        filesEncadeados.erase(fileName);
+    } // verifica se o arquivo é do tipo indexado
       else if (filesIndexados.find(fileName) != filesIndexados.end()) {
         File file = filesIndexados[fileName];
         disk[file.indexBlock] = -1;
@@ -592,19 +2687,81 @@ void deleteArquivo(vector<int>& disk,
             disk[block] = -1;
         }
 
-        // remove o arquivo do map filesIndexados e tabela de diretório
+        // remove o arquivo do map filesIndexados
         filesIndexados.erase(fileName);
-        tabelaDiretorio.erase(fileName);
+    } // verifica se o arquivo é do tipo extents
+      else if (filesExtents.find(fileName) != filesExtents.end()) {
+        File file = filesExtents[fileName];
+        // libera os blocos de todos os extents
+        for (const auto& [inicio, tamanho] : file.extents) {
+            for (int b = inicio; b < inicio + tamanho; ++b) {
+                disk[b] = -1;
+            }
+        }
 
-        cout << "Arquivo " << fileName << " deletado com sucesso!" << endl;
-    } // caso o arquivo não seja encontrado em nenhum dos tipos, informa erro
+        // remove o arquivo do map filesExtents
+        filesExtents.erase(fileName);
+    } // arquivo não encontrado em nenhum dos tipos
       else {
+        return false;
+    }
+
+    tabelaDiretorio.erase(fileName);
+    return true;
+}
+
+void deleteArquivo(vector<int>& disk,
+                   unordered_map<string, File>& filesContiguous, 
+                   unordered_map<string, File>& filesEncadeados, 
+                   unordered_map<string, File>& filesIndexados,
+                   unordered_map<string, File>& filesExtents) {
+    // solicita o nome do arquivo a ser deletado
+    string fileName;
+    cout << "Digite o nome do arquivo a ser deletado: ";
+    cin >> fileName;
+
+    // descarta os dados que ainda estão no buffer da alocação atrasada
+    auto itBuffer = alocacaoAtrasada.buffers.find(fileName);
+    if (itBuffer != alocacaoAtrasada.buffers.end()) {
+        bool somenteNoBuffer = itBuffer->second.novo;
+        alocacaoAtrasada.buffers.erase(itBuffer);
+        if (somenteNoBuffer) {
+            tabelaDiretorio.erase(fileName);
+            cout << "Arquivo " << fileName << " deletado com sucesso!" << endl;
+            return;
+        }
+    }
+
+    // os blocos liberados saem do cache de blocos (podem ser reaproveitados por outro arquivo)
+    auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    if (files != nullptr) {
+        const File& file = files->at(fileName);
+        for (int bloco : blocosDoArquivo(file)) invalidarBlocoCache(cacheBlocos, bloco);
+        if (file.metodo == METODO_INDEXADO) invalidarBlocoCache(cacheBlocos, file.indexBlock);
+    }
+
+    if (removerArquivo(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                       tabelaDiretorio, fileName)) {
+        cout << "Arquivo " << fileName << " deletado com sucesso!" << endl;
+    } else { // caso o arquivo não seja encontrado em nenhum dos tipos, informa erro
         cout << "Erro: Arquivo não encontrado!" << endl;
     }
 }
 
 // display da tabela de diretório para os arquivos de cada método de alocação
+// memória das listas de blocos comparada com um vector<int> por arquivo
+void printMemoriaListas(const unordered_map<string, File>& files) {
+    if (files.empty()) return;
+    size_t compactas = 0, vetores = 0;
+    for (const auto& [nome, file] : files) {
+        compactas += file.dataBlocks.bytesUsados();
+        vetores += sizeof(vector<int>) + bytesNoHeap(file.dataBlocks.size() * sizeof(int));
+    }
+    cout << "Listas de blocos: " << compactas << " bytes compactadas (" << vetores << " como vector<int>)\n";
+}
+
 void displayDiretorioContiguo(const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayDiretorioContiguo");
     cout << "\nTabela de Diretório - Alocação Contígua:\n";
 
     cout << left
@@ -629,6 +2786,7 @@ void displayDiretorioContiguo(const unordered_map<string, File>& files) {
 }
 
 void displayDiretorioEncadeado(const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayDiretorioEncadeado");
     cout << "\nTabela de Diretório - Alocação Encadeada:\n";
 
     cout << left
@@ -653,17 +2811,14 @@ void displayDiretorioEncadeado(const unordered_map<string, File>& files) {
         
         // exibe a cadeia de blocos do arquivo
         cout << "Blocos Encadeados: [";
-        for (size_t i = 0; i < file.dataBlocks.size(); ++i) {
-            cout << file.dataBlocks[i];
-            
-            if (i < file.dataBlocks.size() - 1)
-                cout << " → ";
-        }
+        printListaBlocos(file.dataBlocks, " → ");
         cout << "]\n";
     }
+    printMemoriaListas(files);
 }
 
 void displayDiretorioIndexado(const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayDiretorioIndexado");
     cout << "\nTabela de Diretório - Alocação Indexada:\n";
     
     cout << left
@@ -689,83 +2844,268 @@ void displayDiretorioIndexado(const unordered_map<string, File>& files) {
         
         // exibe os blocos de dados do arquivo
         cout << "Blocos de Dados: [";
-        for (size_t i = 0; i < file.dataBlocks.size(); ++i) {
-            cout << file.dataBlocks[i];
-            if (i < file.dataBlocks.size() - 1)
-                cout << ", ";
-        }
+        printListaBlocos(file.dataBlocks, ", ");
         cout << "]\n";
     }
+    printMemoriaListas(files);
 }
 
-// estender arquivo para cada método de alocação
-void estenderArquivoContiguo(vector<int>& disk, 
-                             unordered_map<string, File>& filesContiguous, 
-                             unordered_map<string, tuple<int,int>>& tabelaDiretorio) {
-    // solicita o nome do arquivo e o número de bytes a serem adicionados
-    string fileName;
-    int adicionalBytes;
+void displayDiretorioExtents(const unordered_map<string, File>& files) {
+    EscopoRastro rastro("displayDiretorioExtents");
+    cout << "\nTabela de Diretório - Alocação por Extents:\n";
 
-    if (!promptExtendCommon(filesContiguous, fileName, adicionalBytes)) {
-        return;
+    cout << left
+         << setw(20) << "Arquivo" << "| "
+         << setw(15) << "Bloco Inicial" << "| "
+         << setw(17) << "Tamanho (blocos)" << "| "
+         << setw(15) << "Tamanho (bytes)" << "| "
+         << setw(12) << "Fragmentação Interna (bytes)" << "\n";
+
+    // linha de separação
+    cout << string(20 + 15 + 17 + 15 + 12 + 30, '-') << "\n";
+
+    // percorre todos os arquivos para exibir suas informações
+    for (const auto &[nome, file] : files) {
+        int fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+        cout << left << setw(20) << nome << "| "
+             << right << setw(15) << file.startBlock << "| "
+             << right << setw(17) << file.size << "| "
+             << right << setw(15) << file.sizeBytes << "| "
+             << right << setw(12) << fragmentacao << "\n";
+
+        // exibe os extents (bloco inicial, tamanho) do arquivo
+        cout << "Extents: [";
+        for (size_t i = 0; i < file.extents.size(); ++i) {
+            cout << "(" << file.extents[i].first << ", " << file.extents[i].second << ")";
+            if (i < file.extents.size() - 1)
+                cout << ", ";
+        }
+        cout << "]\n";
     }
+}
+
+// blocos novos necessários para acrescentar bytes ao arquivo (após ocupar a sobra do último bloco)
+int blocosParaExtensao(int sizeBytes, int adicionalBytes) {
+    auto consumo = consumeLastBlockSpace(sizeBytes, TAMANHO_BLOCO, adicionalBytes);
+    return (consumo.second + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+}
 
+// extensão sem interação para cada método (o arquivo só é alterado em caso de sucesso)
+ResultadoAlocacao alocarExtensaoContiguo(vector<int>& disk,
+                                         unordered_map<string, File>& filesContiguous,
+                                         unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                         const string& fileName, int adicionalBytes) {
+    EscopoRastro rastro("alocarExtensaoContiguo");
     // referência ao arquivo
     File& file = filesContiguous[fileName];
+    int blocosAntes = file.size, bytesAntes = file.sizeBytes;
     int start = file.startBlock;
-    int blocosOcupados = file.size;
     int discoTotalBlocos = (int)disk.size();
 
-    int tamanhoAtualBytes = file.sizeBytes;
+    // consome o espaço livre do último bloco antes de pedir blocos novos
+    int blocosAdicionais = blocosParaExtensao(file.sizeBytes, adicionalBytes);
+    int fimArquivo = start + file.size;
 
-    // consumir espaço livre do último bloco, se houver
-    auto consumo = consumeLastBlockSpace(tamanhoAtualBytes, TAMANHO_BLOCO, adicionalBytes);
-    file.sizeBytes += consumo.first;
-    adicionalBytes = consumo.second;
+    // verifica se há espaço contíguo disponível para os blocos adicionais
+    if (fimArquivo + blocosAdicionais > discoTotalBlocos) {
+        return falhaAlocacao(disk, ERRO_SEM_ESPACO_CONTIGUO, blocosAdicionais);
+    }
+    for (int i = fimArquivo; i < fimArquivo + blocosAdicionais; ++i) {
+        if (disk[i] != -1) {
+            return falhaAlocacao(disk, ERRO_SEM_ESPACO_CONTIGUO, blocosAdicionais);
+        }
+    }
 
-    int blocosAdicionais = 0;
-    if (adicionalBytes > 0) {
-        // calcula blocos adicionais realmente necessários
-        blocosAdicionais = (adicionalBytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    for (int i = fimArquivo; i < fimArquivo + blocosAdicionais; ++i) {
+        disk[i] = start; // marca os novos blocos como ocupados pelo arquivo
     }
 
-    int fimArquivo = start + blocosOcupados;
+    // atualiza tamanho em blocos e bytes
+    file.size += blocosAdicionais;
+    file.sizeBytes += adicionalBytes;
 
-    // verifica se há espaço contíguo disponível para os blocos adicionais
-    bool podeEstender = true;
-    if (fimArquivo + blocosAdicionais > discoTotalBlocos) {
-        podeEstender = false;
-    } else {
-        for (int i = fimArquivo; i < fimArquivo + blocosAdicionais; ++i) {
-            if (disk[i] != -1) {
-                podeEstender = false;
-                break;
+    // recalcula fragmentação interna
+    file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+
+    // atualiza a tabela de diretório
+    tabelaDiretorio[fileName] = make_tuple(file.startBlock, file.size);
+    metricasArquivoEstendido(disk, file, blocosAntes, bytesAntes);
+    return ALOCACAO_OK;
+}
+
+ResultadoAlocacao alocarExtensaoEncadeado(vector<int>& disk,
+                                          unordered_map<string, File>& filesEncadeados,
+                                          unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                          const string& fileName, int adicionalBytes) {
+    EscopoRastro rastro("alocarExtensaoEncadeado");
+    // referência ao arquivo
+    File& file = filesEncadeados[fileName];
+    int blocosAntes = file.size, bytesAntes = file.sizeBytes;
+    int blocosAdicionais = blocosParaExtensao(file.sizeBytes, adicionalBytes);
+
+    if (blocosAdicionais > 0) {
+        // busca blocos livres no disco
+        vector<int> freeBlocks = collectFreeBlocks(disk);
+
+        if ((int)freeBlocks.size() < blocosAdicionais) {
+            return falhaAlocacao(disk, ERRO_ESPACO_INSUFICIENTE, blocosAdicionais);
+        }
+
+        // embaralha blocos livres para distribuição aleatória
+        shuffleInPlace(freeBlocks);
+
+        // atualiza ponteiro do último bloco existente
+        int ultimoBlocoExistente = file.dataBlocks.back();
+        disk[ultimoBlocoExistente] = freeBlocks[0];
+
+        // adiciona os novos blocos à cadeia
+        for (int i = 0; i < blocosAdicionais; ++i) {
+            int atual = freeBlocks[i];
+            file.dataBlocks.push_back(atual);
+
+            if (i < blocosAdicionais - 1) {
+                disk[atual] = freeBlocks[i + 1];
+            } else {
+                disk[atual] = FIM_CADEIA; // fim da cadeia
             }
         }
     }
 
-    // realiza a extensão do arquivo se possível
-    if (podeEstender) {
-        for (int i = fimArquivo; i < fimArquivo + blocosAdicionais; ++i) {
-            disk[i] = start; // marca os novos blocos como ocupados pelo arquivo
+    // atualiza tamanho total e fragmentação
+    file.sizeBytes += adicionalBytes;
+    file.size = (int)file.dataBlocks.size();
+    file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+
+    // atualiza a tabela de diretório
+    tabelaDiretorio[fileName] = make_tuple(file.startBlock, file.size);
+    metricasArquivoEstendido(disk, file, blocosAntes, bytesAntes);
+    return ALOCACAO_OK;
+}
+
+ResultadoAlocacao alocarExtensaoIndexado(vector<int>& disk,
+                                         unordered_map<string, File>& filesIndexados,
+                                         unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                         const string& fileName, int adicionalBytes) {
+    EscopoRastro rastro("alocarExtensaoIndexado");
+    // referência ao arquivo
+    File& file = filesIndexados[fileName];
+    int blocosAntes = file.size, bytesAntes = file.sizeBytes;
+    int blocosAdicionais = blocosParaExtensao(file.sizeBytes, adicionalBytes);
+
+    // limitando o bloco de índice (cada endereço ocupa 1 byte - máximo 8)
+    if ((int)file.dataBlocks.size() + blocosAdicionais > MAX_ENTRADAS_INDICE) {
+        return falhaAlocacao(disk, ERRO_INDICE_CHEIO, blocosAdicionais);
+    }
+
+    if (blocosAdicionais > 0) {
+        // procura por blocos livres no disco
+        vector<int> freeBlocks = collectFreeBlocks(disk);
+
+        if ((int)freeBlocks.size() < blocosAdicionais) {
+            return falhaAlocacao(disk, ERRO_ESPACO_INSUFICIENTE, blocosAdicionais);
+        }
+
+        // embaralha os blocos livres aleatoriamente
+        shuffleInPlace(freeBlocks);
+
+        // adiciona os novos blocos e aponta para o bloco índice
+        for (int i = 0; i < blocosAdicionais; ++i) {
+            int bloco = freeBlocks[i];
+            disk[bloco] = file.indexBlock;
+            file.dataBlocks.push_back(bloco);
+        }
+    }
+
+    // atualiza tamanho total e fragmentação
+    file.sizeBytes += adicionalBytes;
+    file.size = (int)file.dataBlocks.size();
+    file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+    // atualiza a tabela de diretório
+    tabelaDiretorio[fileName] = make_tuple(file.indexBlock, file.size);
+    metricasArquivoEstendido(disk, file, blocosAntes, bytesAntes);
+    return ALOCACAO_OK;
+}
+
+ResultadoAlocacao alocarExtensaoExtents(vector<int>& disk,
+                                        unordered_map<string, File>& filesExtents,
+                                        unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                        const string& fileName, int adicionalBytes) {
+    EscopoRastro rastro("alocarExtensaoExtents");
+    // referência ao arquivo
+    File& file = filesExtents[fileName];
+    int blocosAntes = file.size, bytesAntes = file.sizeBytes;
+    int blocosAdicionais = blocosParaExtensao(file.sizeBytes, adicionalBytes);
+
+    if (blocosAdicionais > 0) {
+        vector<pair<int,int>> extents = file.extents;
+
+        // primeiro tenta crescer o último extent no próprio lugar
+        int fimUltimo = extents.back().first + extents.back().second;
+        int noLugar = 0;
+        while (noLugar < blocosAdicionais && fimUltimo + noLugar < static_cast<int>(disk.size())
+               && disk[fimUltimo + noLugar] == BLOCO_LIVRE) {
+            disk[fimUltimo + noLugar] = file.startBlock; // reserva para não ser escolhido de novo
+            ++noLugar;
+        }
+        extents.back().second += noLugar;
+
+        // o restante vai para novos extents, respeitando o limite por arquivo
+        int restante = blocosAdicionais - noLugar;
+        vector<pair<int,int>> novos;
+        if (restante > 0 && !escolherExtents(disk, restante, MAX_EXTENTS - (int)extents.size(), novos)) {
+            // desfaz a reserva feita no lugar
+            for (int b = fimUltimo; b < fimUltimo + noLugar; ++b) {
+                disk[b] = BLOCO_LIVRE;
+            }
+            return falhaAlocacao(disk, resumirEspacoLivre(disk).blocosLivres < blocosAdicionais
+                                           ? ERRO_ESPACO_INSUFICIENTE : ERRO_LIMITE_EXTENTS, blocosAdicionais);
+        }
+
+        for (const auto& [inicio, tamanho] : novos) {
+            for (int b = inicio; b < inicio + tamanho; ++b) {
+                disk[b] = file.startBlock;
+            }
+            extents.push_back({inicio, tamanho});
         }
+        mesclarExtents(extents);
+        file.extents = extents;
+    }
+
+    // atualiza tamanho total e fragmentação
+    file.sizeBytes += adicionalBytes;
+    file.size += blocosAdicionais;
+    file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
 
-        // atualiza tamanho em blocos
-        file.size += blocosAdicionais;
+    // atualiza a tabela de diretório
+    tabelaDiretorio[fileName] = make_tuple(file.startBlock, file.size);
+    metricasArquivoEstendido(disk, file, blocosAntes, bytesAntes);
+    return ALOCACAO_OK;
+}
 
-        // adiciona o restante dos bytes
-        file.sizeBytes += adicionalBytes;
+// estender arquivo para cada método de alocação
+void estenderArquivoContiguo(vector<int>& disk, 
+                             unordered_map<string, File>& filesContiguous, 
+                             unordered_map<string, tuple<int,int>>& tabelaDiretorio) {
+    // solicita o nome do arquivo e o número de bytes a serem adicionados
+    string fileName;
+    int adicionalBytes;
 
-        // recalcula fragmentação interna
-        file.fragmentacao = (file.size * TAMANHO_BLOCO) - file.sizeBytes;
+    if (!promptExtendCommon(filesContiguous, fileName, adicionalBytes)) {
+        return;
+    }
+    marcarArquivoSujo(filesContiguous, fileName); // a posição antiga também muda de aparência
 
-        // atualiza a tabela de diretório
-        tabelaDiretorio[fileName] = make_tuple(file.startBlock, file.size);
+    ResultadoAlocacao resultado = alocarExtensaoContiguo(disk, filesContiguous, tabelaDiretorio,
+                                                         fileName, adicionalBytes);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
 
-        cout << "Arquivo estendido com sucesso!" << endl;
+    cout << "Arquivo estendido com sucesso!" << endl;
+    marcarArquivoSujo(filesContiguous, fileName);
+    if (!redesenharAlteracoes(disk, {&filesContiguous})) {
         displayContiguo(disk, filesContiguous); // mostra o disco atualizado
-    } else {
-        cout << "Erro: Não há espaço contíguo disponível para extensão!" << endl;
     }
 }
 
@@ -780,64 +3120,19 @@ void estenderArquivoEncadeado(vector<int>& disk,
     if (!promptExtendCommon(filesEncadeados, fileName, adicionalBytes)) {
         return;
     }
-    
-    // referência ao arquivo
-    File& file = filesEncadeados[fileName];
-    auto consumo = consumeLastBlockSpace(file.sizeBytes, TAMANHO_BLOCO, adicionalBytes);
-    int restanteBytes = consumo.second;
-
-    if (restanteBytes == 0) {
-        // nada a alocar em novos blocos
-        file.sizeBytes += adicionalBytes; 
-        file.fragmentacao = computeFragmentation((int)file.dataBlocks.size(), file.sizeBytes);
-        tabelaDiretorio[fileName] = make_tuple(file.startBlock, (int)file.dataBlocks.size());
-        cout << "Arquivo estendido com sucesso!" << endl;
-        displayEncadeado(disk, filesEncadeados);
-        return;
-    }
-
-    // calcula quantos blocos adicionais são necessários
-    int blocosAdicionais = (restanteBytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
-
-    // busca blocos livres no disco
-    vector<int> freeBlocks = collectFreeBlocks(disk);
+    marcarArquivoSujo(filesEncadeados, fileName); // a posição antiga também muda de aparência
 
-    if ((int)freeBlocks.size() < blocosAdicionais) {
+    if (alocarExtensaoEncadeado(disk, filesEncadeados, tabelaDiretorio, fileName, adicionalBytes) != ALOCACAO_OK) {
         cout << "Erro: Espaço insuficiente para estender o arquivo!" << endl;
+        imprimirUltimoDiagnostico();
         return;
     }
 
-    // embaralha blocos livres para distribuição aleatória
-    shuffleInPlace(freeBlocks);
-
-    // atualiza ponteiro do último bloco existente somente se há novos blocos
-    if (!freeBlocks.empty()) {
-        int ultimoBlocoExistente = file.dataBlocks.back();
-        disk[ultimoBlocoExistente] = freeBlocks[0];
-    }
-
-    // adiciona os novos blocos à cadeia
-    for (int i = 0; i < blocosAdicionais; ++i) {
-        int atual = freeBlocks[i];
-        file.dataBlocks.push_back(atual);
-
-        if (i < blocosAdicionais - 1) {
-            disk[atual] = freeBlocks[i + 1];
-        } else {
-            disk[atual] = FIM_CADEIA; // fim da cadeia
-        }
-    }
-
-    // atualiza tamanho total e fragmentação
-    file.sizeBytes += adicionalBytes;
-    file.size = (int)file.dataBlocks.size();
-    file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
-
-    // atualiza a tabela de diretório
-    tabelaDiretorio[fileName] = make_tuple(file.startBlock, file.size);
-
     cout << "Arquivo estendido com sucesso!" << endl;
-    displayEncadeado(disk, filesEncadeados);
+    marcarArquivoSujo(filesEncadeados, fileName);
+    if (!redesenharAlteracoes(disk, {&filesEncadeados})) {
+        displayEncadeado(disk, filesEncadeados);
+    }
 }
 
 void estenderArquivoIndexado(vector<int>& disk, 
@@ -851,303 +3146,4316 @@ void estenderArquivoIndexado(vector<int>& disk,
     if (!promptExtendCommon(filesIndexados, fileName, adicionalBytes)) {
         return;
     }
+    marcarArquivoSujo(filesIndexados, fileName); // a posição antiga também muda de aparência
 
-    // referência ao arquivo
-    File& file = filesIndexados[fileName];
-    auto consumo = consumeLastBlockSpace(file.sizeBytes, TAMANHO_BLOCO, adicionalBytes);
-    file.sizeBytes += consumo.first;
-    int restanteBytes = consumo.second;
-
-    // calcula quantos blocos inteiros adicionais são necessários
-    int blocosAdicionais = (restanteBytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    const File& file = filesIndexados[fileName];
+    int entradasAtuais = (int)file.dataBlocks.size();
+    int blocosAdicionais = blocosParaExtensao(file.sizeBytes, adicionalBytes);
 
-    // limitando o bloco de índice (cada endereço ocupa 1 byte - máximo 8)
-    // verifica se o bloco índice suporta os blocos adicionais
-    int maxEntradasIndice = 8;
-    int entradasAtuais = file.dataBlocks.size();
-    if (entradasAtuais + blocosAdicionais > maxEntradasIndice) {
+    ResultadoAlocacao resultado = alocarExtensaoIndexado(disk, filesIndexados, tabelaDiretorio,
+                                                         fileName, adicionalBytes);
+    if (resultado == ERRO_INDICE_CHEIO) {
         cout << "Erro: Não é possível estender, bloco índice cheio!" << endl;
         cout << "Entradas atuais: " << entradasAtuais 
              << ", blocos a adicionar: " << blocosAdicionais 
-             << ", limite máximo: " << maxEntradasIndice << endl;
+             << ", limite máximo: " << MAX_ENTRADAS_INDICE << endl;
+        return;
+    }
+    if (resultado != ALOCACAO_OK) {
+        cout << "Erro: Espaço insuficiente para estender o arquivo!" << endl;
+        imprimirUltimoDiagnostico();
         return;
     }
 
-    if (blocosAdicionais > 0) {
-        // procura por blocos livres no disco
-        vector<int> freeBlocks = collectFreeBlocks(disk);
+    cout << "Arquivo estendido com sucesso!" << endl;
+    marcarArquivoSujo(filesIndexados, fileName);
+    if (!redesenharAlteracoes(disk, {&filesIndexados})) {
+        displayIndexado(disk, filesIndexados); // mostra o disco atualizado
+    }
+}
 
-        if ((int)freeBlocks.size() < blocosAdicionais) {
-            cout << "Erro: Espaço insuficiente para estender o arquivo!" << endl;
-            return;
+void estenderArquivoExtents(vector<int>& disk,
+                            unordered_map<string, File>& filesExtents,
+                            unordered_map<string, tuple<int,int>>& tabelaDiretorio) {
+    // solicita o nome do arquivo e o número de bytes a serem adicionados
+    string fileName;
+    int adicionalBytes;
+
+    if (!promptExtendCommon(filesExtents, fileName, adicionalBytes)) {
+        return;
+    }
+    marcarArquivoSujo(filesExtents, fileName); // a posição antiga também muda de aparência
+
+    ResultadoAlocacao resultado = alocarExtensaoExtents(disk, filesExtents, tabelaDiretorio,
+                                                        fileName, adicionalBytes);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo estendido com sucesso!" << endl;
+    marcarArquivoSujo(filesExtents, fileName);
+    if (!redesenharAlteracoes(disk, {&filesExtents})) {
+        displayExtents(disk, filesExtents); // mostra o disco atualizado
+    }
+}
+
+// readahead: detecta leitura sequencial por arquivo e busca antecipadamente os próximos blocos,
+// sobrepondo o tempo do dispositivo ao processamento da aplicação
+constexpr int T_PROCESSAMENTO = 1;     // ms que a aplicação gasta em cada bloco lido
+constexpr int JANELA_INICIAL = 4;      // blocos
+constexpr int JANELA_MAXIMA = 32;
+
+struct EstadoReadahead {
+    int janela = JANELA_INICIAL;
+    int ultimoIndice = -1; // último bloco lógico lido (detecção de fluxo sequencial)
+};
+
+struct TotaisReadahead {
+    long long tempoSem = 0;
+    long long tempoCom = 0;
+    int leituras = 0;
+};
+
+unordered_map<string, EstadoReadahead> estadosReadahead;
+unordered_map<int, TotaisReadahead> totaisReadahead; // por método de alocação
+
+// custo no dispositivo: bloco fisicamente seguinte ao último lido é sequencial, o resto exige posicionamento
+int custoDispositivo(int bloco, int& posicao, int t_sequencial, int t_aleatorio) {
+    int custo = (posicao >= 0 && bloco == posicao + 1) ? t_sequencial : t_aleatorio;
+    posicao = bloco;
+    return custo;
+}
+
+// simula a leitura sequencial completa de um arquivo com e sem readahead.
+// enderecosConhecidos: contígua, extents e indexada sabem os endereços da janela inteira e podem
+// reordenar as requisições; na encadeada cada endereço só é conhecido depois de ler o bloco anterior
+void simularReadahead(const string& fileName, int metodo, const vector<int>& blocos, bool enderecosConhecidos,
+                      int blocoIndice = -1, int t_sequencial = modeloTempo.sequencial,
+                      int t_aleatorio = modeloTempo.aleatorio, int t_indice = modeloTempo.indice) {
+    if (blocos.empty()) return;
+    int n = (int)blocos.size();
+
+    // sem readahead: cada bloco é lido sob demanda e só depois processado
+    int posicao = -1;
+    int tempoSem = blocoIndice >= 0 ? t_indice : 0;
+    for (int b : blocos) tempoSem += custoDispositivo(b, posicao, t_sequencial, t_aleatorio) + T_PROCESSAMENTO;
+
+    // com readahead
+    EstadoReadahead& estado = estadosReadahead[fileName];
+    bool fluxoSequencial = (estado.ultimoIndice == -1 || estado.ultimoIndice == n - 1);
+    if (!fluxoSequencial) estado.janela = JANELA_INICIAL;
+
+    posicao = -1;
+    int relogio = blocoIndice >= 0 ? t_indice : 0;  // tempo da aplicação
+    int dispositivoLivre = relogio;                 // instante em que o dispositivo fica livre
+    vector<int> pronto(n, -1);                      // instante em que cada bloco chega na memória
+    int proximoBuscado = 0;                         // primeiro bloco ainda não pedido ao dispositivo
+    int acertos = 0;
+
+    auto buscarJanela = [&](int inicio) {
+        int fim = min(n, inicio + estado.janela);
+        vector<int> ordem;
+        for (int i = inicio; i < fim; ++i) ordem.push_back(i);
+        if (enderecosConhecidos) {
+            // endereços conhecidos: atende a janela em ordem física (menos posicionamentos)
+            sort(ordem.begin(), ordem.end(), [&](int a, int b) { return blocos[a] < blocos[b]; });
+        }
+        int inicioDispositivo = max(relogio, dispositivoLivre);
+        for (int i : ordem) {
+            inicioDispositivo += custoDispositivo(blocos[i], posicao, t_sequencial, t_aleatorio);
+            pronto[i] = inicioDispositivo;
         }
+        dispositivoLivre = inicioDispositivo;
+        proximoBuscado = fim;
+    };
 
-        // embaralha os blocos livres aleatoriamente
-        shuffleInPlace(freeBlocks);
+    for (int i = 0; i < n; ++i) {
+        if (pronto[i] < 0) {
+            // falta: leitura sob demanda e nova janela a partir deste bloco
+            buscarJanela(i);
+            if (estado.janela > JANELA_INICIAL) estado.janela /= 2;
+        } else {
+            ++acertos;
+            if (estado.janela < JANELA_MAXIMA) estado.janela = min(JANELA_MAXIMA, estado.janela * 2);
+        }
 
-        // adiciona os novos blocos e aponta para o bloco índice
-        for (int i = 0; i < blocosAdicionais; ++i) {
-            int bloco = freeBlocks[i];
-            disk[bloco] = file.indexBlock;
-            file.dataBlocks.push_back(bloco);
+        relogio = max(relogio, pronto[i]);
+
+        // readahead assíncrono: ao consumir o meio da janela atual, pede a próxima
+        if (proximoBuscado < n && i >= proximoBuscado - max(1, estado.janela / 2)) {
+            if (enderecosConhecidos) {
+                buscarJanela(proximoBuscado);
+            } else {
+                // encadeada: o próximo endereço só é conhecido quando o bloco anterior chega
+                int anterior = proximoBuscado - 1;
+                int relogioAtual = relogio;
+                relogio = max(relogio, pronto[anterior]);
+                int janelaOriginal = estado.janela;
+                estado.janela = 1;
+                buscarJanela(proximoBuscado);
+                estado.janela = janelaOriginal;
+                relogio = relogioAtual;
+            }
         }
+        relogio += T_PROCESSAMENTO;
+    }
+    estado.ultimoIndice = n - 1;
+
+    int tempoCom = relogio;
+    TotaisReadahead& totais = totaisReadahead[metodo];
+    totais.tempoSem += tempoSem;
+    totais.tempoCom += tempoCom;
+    ++totais.leituras;
+
+    double escondido = tempoSem ? 100.0 * (tempoSem - tempoCom) / tempoSem : 0.0;
+    cout << "Readahead (janela final " << estado.janela << " blocos, " << acertos << "/" << n
+         << " blocos já na memória): " << tempoCom << " ms | sem readahead " << tempoSem << " ms | "
+         << fixed << setprecision(1) << escondido << "% da latência escondida\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// acesso aleatório quebra o fluxo sequencial do arquivo
+void reiniciarReadahead(const string& fileName) {
+    EstadoReadahead& estado = estadosReadahead[fileName];
+    estado.janela = JANELA_INICIAL;
+    estado.ultimoIndice = -2;
+}
 
-        file.sizeBytes += restanteBytes;
+void displayTotaisReadahead() {
+    if (totaisReadahead.empty()) return;
+    cout << "\nReadahead por método (leituras sequenciais simuladas):\n";
+    for (int metodo : {METODO_CONTIGUO, METODO_ENCADEADO, METODO_INDEXADO, METODO_EXTENTS}) {
+        auto it = totaisReadahead.find(metodo);
+        if (it == totaisReadahead.end()) continue;
+        const TotaisReadahead& t = it->second;
+        double escondido = t.tempoSem ? 100.0 * (t.tempoSem - t.tempoCom) / t.tempoSem : 0.0;
+        cout << "  " << setw(10) << left << nomeDoMetodo(metodo) << right << ": " << t.leituras << " leituras | "
+             << t.tempoCom << " ms com readahead | " << t.tempoSem << " ms sem | "
+             << fixed << setprecision(1) << escondido << "% escondido\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
     }
+}
 
-    // atualiza tamanho total e fragmentação
-    file.size = (int)file.dataBlocks.size();
-    file.fragmentacao = (file.size * TAMANHO_BLOCO) - file.sizeBytes;
-    // atualiza a tabela de diretório
-    tabelaDiretorio[fileName] = make_tuple(file.indexBlock, file.size);
+// simular leitura dos arquivos para cada método de alocação
+void simularLeituraArquivoContiguo(const File& file,
+                                   int t_sequencial = modeloTempo.sequencial,
+                                   int t_aleatorio = modeloTempo.aleatorio) {
+    EscopoRastro rastro("simularLeituraArquivoContiguo");
+    const string& fileName = file.name;
 
-    cout << "Arquivo estendido com sucesso!" << endl;
-    displayIndexado(disk, filesIndexados); // mostra o disco atualizado
+    // monta o vetor de blocos do arquivo
+    vector<int> blocosArquivo;
+    for (int i = 0; i < file.size; ++i) {
+        blocosArquivo.push_back(file.startBlock + i);
+    }
+
+    if (blocosArquivo.empty()) {
+        cout << "Erro: Arquivo vazio ou inválido!" << endl;
+        return;
+    }
+
+    int fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+
+    // tempo sequencial: percorre todos os blocos em sequência (1 passo por bloco)
+    int passosSequenciais = (int)blocosArquivo.size();
+    int tempoSequencial = (int)blocosArquivo.size() * t_sequencial;
+
+    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Contígua):\n";
+    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
+    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
+    
+    // imprime a ordem sequencial dos blocos
+    cout << "Ordem sequencial dos blocos: [";
+    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
+        cout << blocosArquivo[i];
+        if (i < blocosArquivo.size() - 1) 
+            cout << ", ";
+    }
+
+    cout << "]\n";
+
+    // mesma leitura passando pelo cache de blocos (se ativo)
+    vector<pair<int,int>> acessos;
+    for (int bloco : blocosArquivo) acessos.push_back({bloco, t_sequencial});
+    lerComCache(acessos, "Leitura sequencial");
+    simularReadahead(fileName, METODO_CONTIGUO, blocosArquivo, true, -1, t_sequencial, t_aleatorio);
+
+    // acesso aleatório: solicita o índice do bloco a ser acessado aleatoriamente
+    int indiceDesejado;
+    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
+    cin >> indiceDesejado;
+
+    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
+        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
+    } else {
+        int blocoReal = blocosArquivo[indiceDesejado];
+        int passosAleatorios = 1; // acesso direto
+        int tempoAleatorio = t_aleatorio;
+
+        cout << "Acesso aleatório ao bloco " << blocoReal << ": " 
+             << passosAleatorios << " passo | " 
+             << tempoAleatorio << " ms\n";
+        lerComCache({{blocoReal, t_aleatorio}}, "Acesso aleatório");
+        reiniciarReadahead(fileName);
+    }
+}
+
+void simularLeituraArquivoEncadeado(const vector<int>& disk,
+                                    const File& file,
+                                    int t_sequencial = modeloTempo.sequencial,
+                                    int t_aleatorio = modeloTempo.aleatorio) {
+    EscopoRastro rastro("simularLeituraArquivoEncadeado");
+    const string& fileName = file.name;
+
+    // monta o vetor de blocos seguindo os ponteiros
+    vector<int> blocosArquivo;
+    int blocoAtual = file.dataBlocks.empty() ? -1 : file.dataBlocks.front();
+
+    while (blocoAtual != -1 && blocoAtual != -2) { //fim da cadeia
+        blocosArquivo.push_back(blocoAtual);
+        blocoAtual = disk[blocoAtual]; // próximo bloco
+    }
+
+    if (blocosArquivo.empty()) {
+        cout << "Erro: Arquivo vazio ou inválido!" << endl;
+        return;
+    }
+
+    int fragmentacao = computeFragmentation(file.size,  file.sizeBytes);
+
+     // custo sequencial: blocos + saltos de ponteiro
+    int passosSequenciais = (int)blocosArquivo.size() * 2 - 1; 
+    int tempoSequencial = (int)blocosArquivo.size() * t_sequencial;
+
+    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Encadeada):\n";
+    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
+    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
+
+    // imprime ordem sequencial dos blocos
+    cout << "Ordem sequencial dos blocos: [";
+    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
+        cout << blocosArquivo[i];
+        if (i < blocosArquivo.size() - 1) cout << ", ";
+    }
+
+    cout << "]\n";
+
+    // mesma leitura passando pelo cache de blocos (se ativo)
+    vector<pair<int,int>> acessos;
+    for (int bloco : blocosArquivo) acessos.push_back({bloco, t_sequencial});
+    lerComCache(acessos, "Leitura sequencial");
+    simularReadahead(fileName, METODO_ENCADEADO, blocosArquivo, false, -1, t_sequencial, t_aleatorio);
+
+    // solicita o índice do bloco a ser acessado aleatoriamente
+    int indiceDesejado;
+    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
+    cin >> indiceDesejado;
+
+    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
+        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
+    } else {
+        // tempo de acesso aleatório: depende da posição (precisa percorrer a cadeia até o bloco desejado)
+        int blocoReal = blocosArquivo[indiceDesejado];
+        int passosAleatorios = (indiceDesejado + 1) * 2 - 1;
+        int tempoAleatorio = (indiceDesejado + 1) * t_aleatorio;
+
+        cout << "Acesso aleatório ao bloco " << blocoReal << ": " << passosAleatorios 
+             << " passos | " << tempoAleatorio << " ms\n";
+
+        // percurso da cadeia encadeada até o bloco desejado
+        cout << "Percurso até o bloco desejado: ";
+        for (int i = 0; i <= indiceDesejado; ++i) {
+            cout << blocosArquivo[i];
+            
+            if (i < indiceDesejado) 
+                cout << " -> ";
+        }
+
+        cout << "\n";
+
+        // cada bloco do percurso precisa ser lido para obter o ponteiro seguinte
+        vector<pair<int,int>> percurso;
+        for (int i = 0; i <= indiceDesejado; ++i) percurso.push_back({blocosArquivo[i], t_aleatorio});
+        lerComCache(percurso, "Acesso aleatório");
+        reiniciarReadahead(fileName);
+    }
+}
+
+void simularLeituraArquivoIndexado(const File& file,
+                                   int t_sequencial = modeloTempo.sequencial,
+                                   int t_aleatorio = modeloTempo.aleatorio,
+                                   int t_indice = modeloTempo.indice) {
+    EscopoRastro rastro("simularLeituraArquivoIndexado");
+    const string& fileName = file.name;
+    vector<int> blocosArquivo = file.dataBlocks.paraVetor();
+
+    if (blocosArquivo.empty()) {
+        cout << "Erro: Arquivo vazio ou inválido!" << endl;
+        return;
+    }
+
+    int fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+
+    // leitura sequencial: ler bloco de índice + percorrer todos os blocos do arquivo
+    int passosSequenciais = 1 + (int)blocosArquivo.size();
+    int tempoSequencial = t_indice + (int)blocosArquivo.size() * t_sequencial;
+
+    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Indexada):\n";
+    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
+    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
+
+    // imprime a ordem sequencial dos blocos
+    cout << "Ordem sequencial dos blocos: [";
+    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
+        cout << blocosArquivo[i];
+        if (i < blocosArquivo.size() - 1) cout << ", ";
+    }
+
+    cout << "]\n";
+
+    // mesma leitura passando pelo cache de blocos (se ativo): o bloco índice também é cacheado
+    vector<pair<int,int>> acessos = {{file.indexBlock, t_indice}};
+    for (int bloco : blocosArquivo) acessos.push_back({bloco, t_sequencial});
+    lerComCache(acessos, "Leitura sequencial");
+    simularReadahead(fileName, METODO_INDEXADO, blocosArquivo, true, file.indexBlock, t_sequencial, t_aleatorio, t_indice);
+
+    // acesso aleatório: índice + bloco
+    int indiceDesejado;
+    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
+    cin >> indiceDesejado;
+
+    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
+        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
+    } else {
+        int blocoReal = blocosArquivo[indiceDesejado];
+        int tempoBloco = t_indice + t_aleatorio;
+
+        cout << "Tempo para acessar o bloco " << blocoReal << " aleatoriamente: " << tempoBloco << " ms\n";
+
+        // percurso do bloco de índice até o bloco desejado
+        cout << "Percurso até o bloco desejado: bloco índice -> " << blocoReal << "\n";
+        lerComCache({{file.indexBlock, t_indice}, {blocoReal, t_aleatorio}}, "Acesso aleatório");
+        reiniciarReadahead(fileName);
+    }
+}
+
+void simularLeituraArquivoExtents(const File& file,
+                                  int t_sequencial = modeloTempo.sequencial,
+                                  int t_aleatorio = modeloTempo.aleatorio) {
+    EscopoRastro rastro("simularLeituraArquivoExtents");
+    const string& fileName = file.name;
+    vector<int> blocosArquivo = blocosDoArquivo(file);
+
+    if (blocosArquivo.empty()) {
+        cout << "Erro: Arquivo vazio ou inválido!" << endl;
+        return;
+    }
+
+    int fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+    int saltos = (int)file.extents.size() - 1; // reposicionamento a cada novo extent
+
+    // tempo sequencial: blocos em sequência + um acesso aleatório por extent adicional
+    int passosSequenciais = (int)blocosArquivo.size() + saltos;
+    int tempoSequencial = (int)blocosArquivo.size() * t_sequencial + saltos * t_aleatorio;
+
+    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Extents):\n";
+    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
+    cout << "Extents: " << file.extents.size() << "\n";
+    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
+
+    // imprime a ordem sequencial dos blocos
+    cout << "Ordem sequencial dos blocos: [";
+    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
+        cout << blocosArquivo[i];
+        if (i < blocosArquivo.size() - 1) cout << ", ";
+    }
+
+    cout << "]\n";
+
+    // mesma leitura passando pelo cache de blocos (se ativo); o primeiro bloco de cada extent adicional paga o salto
+    vector<pair<int,int>> acessos;
+    for (const auto& [inicio, tamanho] : file.extents) {
+        for (int b = inicio; b < inicio + tamanho; ++b) {
+            bool salto = (b == inicio && inicio != file.extents[0].first);
+            acessos.push_back({b, t_sequencial + (salto ? t_aleatorio : 0)});
+        }
+    }
+    lerComCache(acessos, "Leitura sequencial");
+    simularReadahead(fileName, METODO_EXTENTS, blocosArquivo, true, -1, t_sequencial, t_aleatorio);
+
+    // acesso aleatório: o mapa de extents fica na entrada do diretório, então o acesso é direto
+    int indiceDesejado;
+    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
+    cin >> indiceDesejado;
+
+    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
+        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
+    } else {
+        int blocoReal = blocosArquivo[indiceDesejado];
+        cout << "Acesso aleatório ao bloco " << blocoReal << ": 1 passo | " << t_aleatorio << " ms\n";
+        lerComCache({{blocoReal, t_aleatorio}}, "Acesso aleatório");
+        reiniciarReadahead(fileName);
+    }
+}
+
+// solicita o nome do arquivo a ser lido e executa a simulação do método correspondente
+template <typename Simulacao>
+void promptLeitura(const unordered_map<string, File>& files, Simulacao simular) {
+    string fileName;
+    cout << "Digite o nome do arquivo para simular a leitura: ";
+    cin >> fileName;
+
+    // verifica se o arquivo existe
+    auto it = files.find(fileName);
+    if (it == files.end()) {
+        cout << "Erro: Arquivo não encontrado!" << endl;
+        return;
+    }
+    simular(it->second);
+}
+
+void simularLeituraContiguo(const unordered_map<string, File>& filesContiguous) {
+    promptLeitura(filesContiguous, [](const File& file) { simularLeituraArquivoContiguo(file); });
+}
+
+void simularLeituraEncadeado(const vector<int>& disk, const unordered_map<string, File>& filesEncadeados) {
+    promptLeitura(filesEncadeados, [&disk](const File& file) { simularLeituraArquivoEncadeado(disk, file); });
+}
+
+void simularLeituraIndexado(const unordered_map<string, File>& filesIndexados) {
+    promptLeitura(filesIndexados, [](const File& file) { simularLeituraArquivoIndexado(file); });
+}
+
+void simularLeituraExtents(const unordered_map<string, File>& filesExtents) {
+    promptLeitura(filesExtents, [](const File& file) { simularLeituraArquivoExtents(file); });
+}
+
+// modo misto: arquivos de todos os métodos no mesmo disco
+constexpr int LIMIAR_ARQUIVO_PEQUENO = 4; // em blocos
+
+// modo adaptativo: escolhe o método pelo tamanho do arquivo e pela expectativa de crescimento
+int escolherMetodoAdaptativo(const vector<int>& disk, int tamanhoBlocos, bool vaiCrescer) {
+    ResumoEspacoLivre livre = resumirEspacoLivre(disk);
+
+    // arquivos pequenos ou que não crescem: contígua (leitura mais barata), se houver trecho livre suficiente
+    if ((!vaiCrescer || tamanhoBlocos <= LIMIAR_ARQUIVO_PEQUENO) && livre.maiorTrecho >= tamanhoBlocos) {
+        return METODO_CONTIGUO;
+    }
+
+    // arquivos que crescem: indexada enquanto o bloco índice tiver folga para o crescimento
+    int entradasPrevistas = vaiCrescer ? tamanhoBlocos * 2 : tamanhoBlocos;
+    if (entradasPrevistas <= MAX_ENTRADAS_INDICE) {
+        return METODO_INDEXADO;
+    }
+
+    // arquivos grandes: extents (leitura quase contígua e extensão no lugar)
+    vector<pair<int,int>> extents;
+    if (escolherExtents(disk, tamanhoBlocos, MAX_EXTENTS, extents)) {
+        return METODO_EXTENTS;
+    }
+
+    // espaço livre fragmentado demais para extents: encadeada (não tem limite de blocos)
+    return METODO_ENCADEADO;
+}
+
+ResultadoAlocacao alocarArquivoMisto(vector<int>& disk,
+                                     unordered_map<string, File>& filesContiguous,
+                                     unordered_map<string, File>& filesEncadeados,
+                                     unordered_map<string, File>& filesIndexados,
+                                     unordered_map<string, File>& filesExtents,
+                                     unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                     int metodo, const string& fileName, int tamanhoBytes, int tamanhoBlocos,
+                                     int& fileID) {
+    if (metodo == METODO_CONTIGUO)
+        return alocarArquivoContiguo(disk, filesContiguous, tabelaDiretorio, fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    if (metodo == METODO_ENCADEADO)
+        return alocarArquivoEncadeado(disk, filesEncadeados, tabelaDiretorio, fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    if (metodo == METODO_INDEXADO)
+        return alocarArquivoIndexado(disk, filesIndexados, tabelaDiretorio, fileName, tamanhoBytes, tamanhoBlocos, fileID);
+    return alocarArquivoExtents(disk, filesExtents, tabelaDiretorio, fileName, tamanhoBytes, tamanhoBlocos, fileID);
+}
+
+ResultadoAlocacao alocarExtensaoMisto(vector<int>& disk,
+                                      unordered_map<string, File>& filesContiguous,
+                                      unordered_map<string, File>& filesEncadeados,
+                                      unordered_map<string, File>& filesIndexados,
+                                      unordered_map<string, File>& filesExtents,
+                                      unordered_map<string, tuple<int,int>>& tabelaDiretorio,
+                                      const string& fileName, int adicionalBytes) {
+    if (filesContiguous.count(fileName))
+        return alocarExtensaoContiguo(disk, filesContiguous, tabelaDiretorio, fileName, adicionalBytes);
+    if (filesEncadeados.count(fileName))
+        return alocarExtensaoEncadeado(disk, filesEncadeados, tabelaDiretorio, fileName, adicionalBytes);
+    if (filesIndexados.count(fileName))
+        return alocarExtensaoIndexado(disk, filesIndexados, tabelaDiretorio, fileName, adicionalBytes);
+    return alocarExtensaoExtents(disk, filesExtents, tabelaDiretorio, fileName, adicionalBytes);
+}
+
+void displayMisto(const vector<int>& disk,
+                  const unordered_map<string, File>& filesContiguous,
+                  const unordered_map<string, File>& filesEncadeados,
+                  const unordered_map<string, File>& filesIndexados,
+                  const unordered_map<string, File>& filesExtents) {
+    EscopoRastro rastro("displayMisto");
+    if (disk.size() > LIMITE_DESENHO_POR_BLOCO) {
+        displayMapaCompacto(disk, {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}, 0,
+                            static_cast<int>(disk.size()) - 1, 0);
+        return;
+    }
+    cout << "Memória Mista:" << endl;
+
+    // map que associa cada bloco a uma tuple: (arquivo, posição no arquivo (-1 = bloco índice), total de blocos, bytes usados)
+    unordered_map<int, tuple<const File*, int, int, int>> blockInfo;
+
+    for (const auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+        for (const auto &[nome, file] : *files) {
+            vector<int> blocos = blocosDoArquivo(file);
+            int totalBlocks = static_cast<int>(blocos.size());
+
+            for (int idx = 0; idx < totalBlocks; ++idx) {
+                if (blocos[idx] < 0 || blocos[idx] >= static_cast<int>(disk.size()))
+                    continue;
+                blockInfo[blocos[idx]] = make_tuple(&file, idx, totalBlocks, bytesUsedForBlock(file.sizeBytes, idx, totalBlocks));
+            }
+            if (file.metodo == METODO_INDEXADO && file.indexBlock >= 0 && file.indexBlock < static_cast<int>(disk.size())) {
+                blockInfo[file.indexBlock] = make_tuple(&file, -1, totalBlocks, TAMANHO_BLOCO);
+            }
+        }
+    }
+
+    int totalBytesLivres = 0;
+
+    for (size_t i = 0; i < disk.size(); ++i) {
+        auto itInfo = blockInfo.find(static_cast<int>(i));
+
+        if (itInfo == blockInfo.end()) {
+            // bloco livre ou desconhecido
+            if (disk[i] == BLOCO_LIVRE) {
+                printFreeBlock(i);
+                cout << endl;
+                totalBytesLivres += TAMANHO_BLOCO;
+            } else {
+                cout << "[" << i << "] █ → ?" << endl;
+            }
+            continue;
+        }
+
+        auto [file, pos, totalBlocks, bytesUsed] = itInfo->second;
+        printColoredBlockBar(i, file->color, bytesUsed);
+
+        if (pos == -1) {
+            cout << " → BLOCO ÍNDICE do " << file->name << " → [";
+            printListaBlocos(file->dataBlocks, ", ");
+            cout << "]";
+        } else if (totalBlocks == 1) {
+            cout << " → INICIO/FIM do " << file->name;
+        } else if (pos == 0) {
+            cout << " → INICIO do " << file->name;
+        } else if (pos == totalBlocks - 1) {
+            cout << " → FIM do " << file->name;
+        } else {
+            cout << " [" << file->name << "]";
+        }
+
+        // arquivos encadeados também mostram o ponteiro para o próximo bloco
+        if (file->metodo == METODO_ENCADEADO && pos >= 0 && disk[i] != FIM_CADEIA) {
+            cout << " → [" << disk[i] << "]";
+        }
+        cout << " (" << nomeDoMetodo(file->metodo) << ")" << endl;
+
+        totalBytesLivres += (TAMANHO_BLOCO - bytesUsed); // fragmentação interna
+    }
+
+    printFreeBytesFooter(totalBytesLivres);
+}
+
+// resumo do disco misto: fragmentação e custo de leitura estimado por método
+// (mesmo modeloTempo e mesmas fórmulas de simularLeituraArquivo*)
+void displayResumoMisto(const vector<int>& disk,
+                        const unordered_map<string, File>& filesContiguous,
+                        const unordered_map<string, File>& filesEncadeados,
+                        const unordered_map<string, File>& filesIndexados,
+                        const unordered_map<string, File>& filesExtents) {
+    EscopoRastro rastro("displayResumoMisto");
+    cout << "\nResumo do Disco Misto:\n";
+    cout << left
+         << setw(12) << "Método" << "| "
+         << setw(9) << "Arquivos" << "| "
+         << setw(7) << "Blocos" << "| "
+         << setw(22) << "Frag. Interna (bytes)" << "| "
+         << setw(20) << "Leitura seq. (ms)" << "| "
+         << setw(20) << "Acesso aleat. (ms)" << "\n";
+    cout << string(12 + 9 + 7 + 22 + 20 + 20 + 10, '-') << "\n";
+
+    const vector<pair<int, const unordered_map<string, File>*>> metodos = {
+        {METODO_CONTIGUO, &filesContiguous}, {METODO_ENCADEADO, &filesEncadeados},
+        {METODO_INDEXADO, &filesIndexados}, {METODO_EXTENTS, &filesExtents}};
+
+    for (const auto& [metodo, files] : metodos) {
+        int blocos = 0, fragmentacao = 0;
+        double leituraSequencial = 0, acessoAleatorio = 0;
+
+        for (const auto &[nome, file] : *files) {
+            blocos += file.size + (metodo == METODO_INDEXADO ? 1 : 0);
+            fragmentacao += computeFragmentation(file.size, file.sizeBytes);
+
+            if (metodo == METODO_CONTIGUO) {
+                leituraSequencial += file.size * modeloTempo.sequencial;
+                acessoAleatorio += modeloTempo.aleatorio;
+            } else if (metodo == METODO_ENCADEADO) {
+                leituraSequencial += file.size * modeloTempo.sequencial;
+                acessoAleatorio += (file.size + 1) / 2.0 * modeloTempo.aleatorio; // posição média na cadeia
+            } else if (metodo == METODO_EXTENTS) {
+                // um posicionamento por extent adicional
+                leituraSequencial += file.size * modeloTempo.sequencial
+                                     + max(0, (int)file.extents.size() - 1) * modeloTempo.aleatorio;
+                acessoAleatorio += modeloTempo.aleatorio;
+            } else {
+                leituraSequencial += modeloTempo.indice + file.size * modeloTempo.sequencial;
+                acessoAleatorio += modeloTempo.indice + modeloTempo.aleatorio;
+            }
+        }
+
+        int quantidade = static_cast<int>(files->size());
+        cout << left << setw(12) << nomeDoMetodo(metodo) << "| "
+             << right << setw(9) << quantidade << "| "
+             << right << setw(7) << blocos << "| "
+             << right << setw(22) << fragmentacao << "| " << fixed << setprecision(1)
+             << right << setw(20) << (quantidade ? leituraSequencial / quantidade : 0.0) << "| "
+             << right << setw(20) << (quantidade ? acessoAleatorio / quantidade : 0.0) << "\n";
+    }
+
+    // fragmentação externa: quanto do espaço livre não está no maior trecho contíguo
+    ResumoEspacoLivre livre = resumirEspacoLivre(disk);
+    double fragExterna = livre.blocosLivres ? 1.0 - (double)livre.maiorTrecho / livre.blocosLivres : 0.0;
+    cout << "Blocos livres: " << livre.blocosLivres << " | Trechos livres: " << livre.trechos
+         << " | Maior trecho: " << livre.maiorTrecho
+         << " | Fragmentação externa: " << setprecision(2) << fragExterna * 100 << "%\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// pergunta o método do arquivo no modo misto (0 se a opção for inválida)
+int promptMetodoArquivo(const vector<int>& disk, int tamanhoBlocos) {
+    int metodo;
+    cout << "Método de alocação do arquivo:\n1. Contígua\n2. Encadeada\n3. Indexada\n4. Extents\n5. Adaptativo\n";
+    cin >> metodo;
+    if (cin.fail() || metodo < 1 || metodo > 5) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Opção inválida!" << endl;
+        return 0;
+    }
+
+    if (metodo == 5) {
+        char resposta;
+        cout << "O arquivo deve crescer depois? (s/n): ";
+        cin >> resposta;
+        metodo = escolherMetodoAdaptativo(disk, tamanhoBlocos, resposta == 's' || resposta == 'S');
+        cout << "Método escolhido: " << nomeDoMetodo(metodo) << endl;
+    }
+    return metodo;
+}
+
+void criarArquivoMisto(vector<int>& disk,
+                       unordered_map<string, File>& filesContiguous,
+                       unordered_map<string, File>& filesEncadeados,
+                       unordered_map<string, File>& filesIndexados,
+                       unordered_map<string, File>& filesExtents,
+                       int& fileID) {
+    string fileName;
+    int tamanhoBytes;
+    int tamanhoBlocos;
+
+    if (!promptCreateCommon(tabelaDiretorio, disk, fileName, tamanhoBytes, tamanhoBlocos)) {
+        return;
+    }
+
+    int metodo = promptMetodoArquivo(disk, tamanhoBlocos);
+    if (metodo == 0) {
+        return;
+    }
+
+    ResultadoAlocacao resultado = alocarArquivoMisto(disk, filesContiguous, filesEncadeados, filesIndexados,
+                                                     filesExtents, tabelaDiretorio, metodo, fileName, tamanhoBytes,
+                                                     tamanhoBlocos, fileID);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo criado com sucesso!" << endl;
+    if (auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents)) {
+        marcarArquivoSujo(*files, fileName);
+    }
+    if (!redesenharAlteracoes(disk, {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents})) {
+        displayMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    }
+}
+
+void estenderArquivoMisto(vector<int>& disk,
+                          unordered_map<string, File>& filesContiguous,
+                          unordered_map<string, File>& filesEncadeados,
+                          unordered_map<string, File>& filesIndexados,
+                          unordered_map<string, File>& filesExtents) {
+    string fileName;
+    int adicionalBytes;
+
+    if (!promptExtendCommon(tabelaDiretorio, fileName, adicionalBytes)) {
+        return;
+    }
+    auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    if (files != nullptr) marcarArquivoSujo(*files, fileName); // a posição antiga também muda de aparência
+
+    ResultadoAlocacao resultado = alocarExtensaoMisto(disk, filesContiguous, filesEncadeados, filesIndexados,
+                                                      filesExtents, tabelaDiretorio, fileName, adicionalBytes);
+    if (resultado != ALOCACAO_OK) {
+        imprimirErroAlocacao(resultado);
+        return;
+    }
+
+    cout << "Arquivo estendido com sucesso!" << endl;
+    if (files != nullptr) marcarArquivoSujo(*files, fileName);
+    if (!redesenharAlteracoes(disk, {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents})) {
+        displayMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    }
+}
+
+void simularLeituraMisto(const vector<int>& disk,
+                         unordered_map<string, File>& filesContiguous,
+                         unordered_map<string, File>& filesEncadeados,
+                         unordered_map<string, File>& filesIndexados,
+                         unordered_map<string, File>& filesExtents) {
+    EscopoRastro rastro("simularLeituraMisto");
+    string fileName;
+    cout << "Digite o nome do arquivo para simular a leitura: ";
+    cin >> fileName;
+
+    auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    if (files == nullptr) {
+        cout << "Erro: Arquivo não encontrado!" << endl;
+        return;
+    }
+
+    const File& file = files->at(fileName);
+    if (file.metodo == METODO_CONTIGUO) {
+        simularLeituraArquivoContiguo(file);
+    } else if (file.metodo == METODO_ENCADEADO) {
+        simularLeituraArquivoEncadeado(disk, file);
+    } else if (file.metodo == METODO_EXTENTS) {
+        simularLeituraArquivoExtents(file);
+    } else {
+        simularLeituraArquivoIndexado(file);
+    }
+}
+
+// E/S assíncrona (modelo no estilo io_uring): a aplicação põe requisições de leitura na fila de
+// submissão e recolhe os resultados da fila de conclusão, com até `profundidade` requisições em voo.
+// O dispositivo atende até CANAIS_DISPOSITIVO requisições ao mesmo tempo (como os canais de um SSD);
+// o custo de cada uma segue custoDispositivo em relação à requisição despachada antes dela
+constexpr int CANAIS_DISPOSITIVO = 8;
+constexpr int PROFUNDIDADE_MAXIMA_IO = 32;
+
+// leituras de um arquivo. Na encadeada cada endereço só é conhecido quando a leitura anterior
+// conclui; na indexada os dados só podem ser pedidos depois que o bloco índice chega
+struct FluxoLeitura {
+    vector<int> blocos;
+    bool encadeado = false;
+    size_t barreira = 0;  // quantas leituras iniciais precisam concluir antes das demais serem submetidas
+    size_t proximo = 0;   // próxima leitura a submeter
+    size_t concluidas = 0;
+    int emVoo = 0;
+};
+
+struct ResultadoFilaIO {
+    long long tempo = 0;           // ms até a última conclusão
+    long long requisicoes = 0;
+    long long somaLatencias = 0;   // da submissão até a conclusão
+    int maxEmVoo = 0;
+};
+
+FluxoLeitura fluxoDoArquivo(const File& file) {
+    FluxoLeitura fluxo;
+    if (file.metodo == METODO_INDEXADO) {
+        fluxo.blocos.push_back(file.indexBlock);
+        fluxo.barreira = 1;
+    }
+    for (int bloco : blocosDoArquivo(file)) fluxo.blocos.push_back(bloco);
+    fluxo.encadeado = file.metodo == METODO_ENCADEADO;
+    return fluxo;
+}
+
+bool podeSubmeter(const FluxoLeitura& fluxo) {
+    if (fluxo.proximo >= fluxo.blocos.size()) return false;
+    if (fluxo.encadeado) return fluxo.emVoo == 0;
+    return fluxo.proximo < fluxo.barreira || fluxo.concluidas >= fluxo.barreira;
+}
+
+// simulação por eventos: enche a fila de submissão, avança o relógio até a próxima conclusão e repete.
+// A aplicação submete tudo o que já conhece de um arquivo e só passa ao seguinte quando ele trava
+// (encadeada esperando o ponteiro, indexada esperando o índice ou arquivo terminado)
+ResultadoFilaIO simularFilaIO(vector<FluxoLeitura> fluxos, int profundidade,
+                              int t_sequencial = modeloTempo.sequencial, int t_aleatorio = modeloTempo.aleatorio) {
+    ResultadoFilaIO resultado;
+    vector<long long> canalLivre(CANAIS_DISPOSITIVO, 0);
+    using Conclusao = tuple<long long, long long, size_t>; // instante, submissão, fluxo
+    priority_queue<Conclusao, vector<Conclusao>, greater<Conclusao>> filaConclusao;
+    long long relogio = 0;
+    int emVoo = 0, posicao = -1;
+    size_t vez = 0;
+
+    while (true) {
+        for (size_t tentativas = 0; emVoo < profundidade && tentativas < fluxos.size(); ) {
+            FluxoLeitura& fluxo = fluxos[vez];
+            if (!podeSubmeter(fluxo)) {
+                vez = (vez + 1) % fluxos.size();
+                ++tentativas;
+                continue;
+            }
+            auto canal = min_element(canalLivre.begin(), canalLivre.end());
+            long long inicio = max(relogio, *canal);
+            *canal = inicio + custoDispositivo(fluxo.blocos[fluxo.proximo++], posicao, t_sequencial, t_aleatorio);
+            filaConclusao.emplace(*canal, relogio, vez);
+            fluxo.emVoo++;
+            resultado.maxEmVoo = max(resultado.maxEmVoo, ++emVoo);
+            tentativas = 0;
+        }
+        if (filaConclusao.empty()) break;
+
+        auto [concluida, submetida, indice] = filaConclusao.top();
+        filaConclusao.pop();
+        relogio = concluida;
+        emVoo--;
+        fluxos[indice].emVoo--;
+        fluxos[indice].concluidas++;
+        resultado.requisicoes++;
+        resultado.somaLatencias += concluida - submetida;
+    }
+    resultado.tempo = relogio;
+    return resultado;
+}
+
+// tabela de vazão por profundidade da fila para cada método com arquivos a ler
+void displayVazaoPorProfundidade(const map<int, vector<FluxoLeitura>>& fluxosPorMetodo) {
+    vector<int> profundidades;
+    for (int p = 1; p <= PROFUNDIDADE_MAXIMA_IO; p *= 2) profundidades.push_back(p);
+
+    cout << "\nE/S assíncrona: vazão (blocos/ms) e latência média (ms) por profundidade da fila ("
+         << CANAIS_DISPOSITIVO << " canais no dispositivo)\n";
+    cout << setw(10) << left << "Método" << right;
+    for (int p : profundidades) cout << setw(13) << ("QD " + to_string(p));
+    cout << "\n";
+    cout << fixed;
+    for (const auto& [metodo, fluxos] : fluxosPorMetodo) {
+        cout << preencherColuna(nomeDoMetodo(metodo), 10);
+        for (int p : profundidades) {
+            ResultadoFilaIO r = simularFilaIO(fluxos, p);
+            double vazao = r.tempo ? (double)r.requisicoes / r.tempo : 0.0;
+            double latencia = r.requisicoes ? (double)r.somaLatencias / r.requisicoes : 0.0;
+            ostringstream celula;
+            celula << fixed << setprecision(2) << vazao << " / " << setprecision(1) << latencia;
+            cout << setw(13) << celula.str();
+        }
+        cout << "\n";
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    if (fluxosPorMetodo.count(METODO_ENCADEADO))
+        cout << "(na encadeada cada leitura depende do ponteiro gravado no bloco anterior: a fila só ajuda ao ler\n"
+                " vários arquivos ao mesmo tempo)\n";
+}
+
+void simularLeituraAssincronaMenu(unordered_map<string, File>& filesContiguous,
+                                  unordered_map<string, File>& filesEncadeados,
+                                  unordered_map<string, File>& filesIndexados,
+                                  unordered_map<string, File>& filesExtents) {
+    EscopoRastro rastro("simularLeituraAssincronaMenu");
+    string fileName;
+    cout << "Digite o nome do arquivo (ou * para ler todos os arquivos de cada método ao mesmo tempo): ";
+    cin >> fileName;
+
+    map<int, vector<FluxoLeitura>> fluxosPorMetodo;
+    if (fileName == "*") {
+        for (auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+            for (const auto& [nome, file] : *files) fluxosPorMetodo[file.metodo].push_back(fluxoDoArquivo(file));
+        }
+    } else {
+        auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+        if (files == nullptr) {
+            cout << "Erro: Arquivo não encontrado!" << endl;
+            return;
+        }
+        const File& file = files->at(fileName);
+        fluxosPorMetodo[file.metodo].push_back(fluxoDoArquivo(file));
+    }
+    if (fluxosPorMetodo.empty()) {
+        cout << "Nenhum arquivo para ler." << endl;
+        return;
+    }
+    displayVazaoPorProfundidade(fluxosPorMetodo);
+}
+
+// alocação atrasada (write-back): criações e extensões ficam no buffer sujo do arquivo
+// e os blocos só são escolhidos no flush (sincronização explícita, tick do temporizador ou pressão de memória)
+// (estado declarado junto da tabela de diretório)
+// descarrega os buffers sujos: uma única chamada ao alocador por arquivo, com todos os bytes acumulados
+void descarregarBuffers(vector<int>& disk,
+                        unordered_map<string, File>& filesContiguous,
+                        unordered_map<string, File>& filesEncadeados,
+                        unordered_map<string, File>& filesIndexados,
+                        unordered_map<string, File>& filesExtents,
+                        int& fileID,
+                        const string& motivo) {
+    if (alocacaoAtrasada.buffers.empty()) return;
+
+    cout << "Flush dos buffers (" << motivo << "): " << alocacaoAtrasada.buffers.size() << " arquivo(s), "
+         << totalBytesSujos(alocacaoAtrasada) << " bytes" << endl;
+
+    for (auto it = alocacaoAtrasada.buffers.begin(); it != alocacaoAtrasada.buffers.end();) {
+        const string& nome = it->first;
+        BufferSujo& buffer = it->second;
+        ResultadoAlocacao resultado;
+
+        if (buffer.novo) {
+            int tamanhoBlocos = (buffer.bytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+            tabelaDiretorio.erase(nome); // a entrada provisória é substituída pela definitiva
+            resultado = alocarArquivoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                           tabelaDiretorio, buffer.metodo, nome, buffer.bytes, tamanhoBlocos, fileID);
+        } else {
+            resultado = alocarExtensaoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                            tabelaDiretorio, nome, buffer.bytes);
+        }
+        ++alocacaoAtrasada.chamadasAlocador;
+
+        if (resultado != ALOCACAO_OK) {
+            // a reserva feita no buffer não garante espaço contíguo nem o limite de extents: em vez de
+            // ficar tentando a cada flush, os dados do buffer são descartados
+            cout << "Falha no flush de " << nome << ": ";
+            imprimirErroAlocacao(resultado);
+            if (buffer.novo) {
+                tabelaDiretorio.erase(nome);
+                cout << "Buffer descartado: o arquivo " << nome << " (" << buffer.bytes << " bytes) não foi criado." << endl;
+            } else {
+                cout << "Buffer descartado: a extensão de " << buffer.bytes << " bytes de " << nome
+                     << " foi perdida." << endl;
+            }
+        }
+        it = alocacaoAtrasada.buffers.erase(it);
+    }
+    alocacaoAtrasada.operacoesDesdeFlush = 0;
+}
+
+void displayEstatisticasAtrasada() {
+    // buffers ainda pendentes vão custar uma chamada cada no próximo flush
+    int economizadas = alocacaoAtrasada.operacoesAdiadas - alocacaoAtrasada.chamadasAlocador
+                     - (int)alocacaoAtrasada.buffers.size();
+    cout << "Alocação atrasada: " << alocacaoAtrasada.operacoesAdiadas << " operações adiadas | "
+         << alocacaoAtrasada.chamadasAlocador << " chamadas ao alocador | "
+         << max(0, economizadas) << " chamadas economizadas | "
+         << totalBytesSujos(alocacaoAtrasada) << " bytes sujos pendentes" << endl;
+}
+
+// blocos que o buffer vai pedir ao alocador no flush (uma indexada nova também pede o bloco índice)
+int blocosDoBuffer(const BufferSujo& buffer, const File* file) {
+    if (file == nullptr) {
+        return (buffer.bytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO + (buffer.metodo == METODO_INDEXADO ? 1 : 0);
+    }
+    return blocosParaExtensao(file->sizeBytes, buffer.bytes);
+}
+
+// reserva no momento do buffer: os blocos de todos os buffers, com este pedido incluído, têm de caber
+// nos blocos livres, e uma indexada não pode passar do limite do índice
+ResultadoAlocacao reservarBuffer(const vector<int>& disk,
+                                 unordered_map<string, File>& filesContiguous,
+                                 unordered_map<string, File>& filesEncadeados,
+                                 unordered_map<string, File>& filesIndexados,
+                                 unordered_map<string, File>& filesExtents,
+                                 const string& fileName, int metodo, int bytes, bool novo) {
+    auto arquivoDe = [&](const string& nome) -> const File* {
+        auto* files = buscarMapaDoArquivo(nome, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+        return files ? &files->at(nome) : nullptr;
+    };
+    int reservados = 0;
+    for (const auto& [nome, buffer] : alocacaoAtrasada.buffers) {
+        if (nome != fileName) reservados += blocosDoBuffer(buffer, arquivoDe(nome));
+    }
+    BufferSujo pedido;
+    auto it = alocacaoAtrasada.buffers.find(fileName);
+    if (it != alocacaoAtrasada.buffers.end()) pedido = it->second;
+    if (pedido.bytes == 0) {
+        pedido.metodo = metodo;
+        pedido.novo = novo;
+    }
+    pedido.bytes += bytes;
+    const File* file = arquivoDe(fileName);
+    int necessarios = blocosDoBuffer(pedido, file);
+
+    if (pedido.metodo == METODO_INDEXADO) {
+        int entradas = file ? (int)file->dataBlocks.size() + necessarios : necessarios - 1;
+        if (entradas > MAX_ENTRADAS_INDICE) return ERRO_INDICE_CHEIO;
+    }
+    const MetricasVolume* metricas = metricasDoDisco(disk);
+    int livres = metricas ? metricas->blocosLivres : (int)count(disk.begin(), disk.end(), BLOCO_LIVRE);
+    if (reservados + necessarios > livres) return ERRO_ESPACO_INSUFICIENTE;
+    return ALOCACAO_OK;
+}
+
+// acumula bytes no buffer do arquivo e aplica a política de pressão de memória;
+// recusa na hora o que o flush não teria como alocar
+bool registrarBufferSujo(vector<int>& disk,
+                         unordered_map<string, File>& filesContiguous,
+                         unordered_map<string, File>& filesEncadeados,
+                         unordered_map<string, File>& filesIndexados,
+                         unordered_map<string, File>& filesExtents,
+                         int& fileID,
+                         const string& fileName, int metodo, int bytes, bool novo) {
+    ResultadoAlocacao reserva = reservarBuffer(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                               fileName, metodo, bytes, novo);
+    if (reserva != ALOCACAO_OK) {
+        if (reserva == ERRO_ESPACO_INSUFICIENTE) {
+            cout << "Erro: Espaço insuficiente no disco para os buffers pendentes!" << endl;
+        } else {
+            imprimirErroAlocacao(reserva);
+        }
+        return false;
+    }
+
+    BufferSujo& buffer = alocacaoAtrasada.buffers[fileName];
+    if (buffer.bytes == 0) {
+        buffer.metodo = metodo;
+        buffer.novo = novo;
+    }
+    buffer.bytes += bytes;
+    ++alocacaoAtrasada.operacoesAdiadas;
+
+    if (totalBytesSujos(alocacaoAtrasada) > alocacaoAtrasada.limiteBytesSujos) {
+        descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID,
+                           "pressão de memória");
+    }
+    return true;
+}
+
+void criarArquivoAtrasado(vector<int>& disk,
+                          unordered_map<string, File>& filesContiguous,
+                          unordered_map<string, File>& filesEncadeados,
+                          unordered_map<string, File>& filesIndexados,
+                          unordered_map<string, File>& filesExtents,
+                          int& fileID,
+                          int tipoAlocacao) {
+    string fileName;
+    int tamanhoBytes;
+    int tamanhoBlocos;
+
+    if (!promptCreateCommon(tabelaDiretorio, disk, fileName, tamanhoBytes, tamanhoBlocos)) {
+        return;
+    }
+
+    int metodo = tipoAlocacao;
+    if (tipoAlocacao == METODO_MISTO) {
+        metodo = promptMetodoArquivo(disk, tamanhoBlocos);
+        if (metodo == 0) {
+            return;
+        }
+    }
+
+    // entrada provisória no diretório (sem blocos) para reservar o nome
+    tabelaDiretorio[fileName] = make_tuple(-1, 0);
+    if (!registrarBufferSujo(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID,
+                             fileName, metodo, tamanhoBytes, true)) {
+        tabelaDiretorio.erase(fileName);
+        return;
+    }
+    cout << "Arquivo criado no buffer (blocos serão alocados no flush)." << endl;
+}
+
+void estenderArquivoAtrasado(vector<int>& disk,
+                             unordered_map<string, File>& filesContiguous,
+                             unordered_map<string, File>& filesEncadeados,
+                             unordered_map<string, File>& filesIndexados,
+                             unordered_map<string, File>& filesExtents,
+                             int& fileID) {
+    string fileName;
+    int adicionalBytes;
+
+    if (!promptExtendCommon(tabelaDiretorio, fileName, adicionalBytes)) {
+        return;
+    }
+
+    auto* files = buscarMapaDoArquivo(fileName, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    auto itBuffer = alocacaoAtrasada.buffers.find(fileName);
+    if (files == nullptr && itBuffer == alocacaoAtrasada.buffers.end()) {
+        cout << "Erro: Arquivo não encontrado!" << endl;
+        return;
+    }
+    int metodo = files ? files->at(fileName).metodo : itBuffer->second.metodo;
+    if (!registrarBufferSujo(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID,
+                             fileName, metodo, adicionalBytes, files == nullptr)) {
+        return;
+    }
+    cout << "Extensão registrada no buffer do arquivo." << endl;
+}
+
+// tick do temporizador: chamado após cada operação do menu
+void tickAlocacaoAtrasada(vector<int>& disk,
+                          unordered_map<string, File>& filesContiguous,
+                          unordered_map<string, File>& filesEncadeados,
+                          unordered_map<string, File>& filesIndexados,
+                          unordered_map<string, File>& filesExtents,
+                          int& fileID) {
+    if (!alocacaoAtrasada.ativa) return;
+    if (++alocacaoAtrasada.operacoesDesdeFlush >= alocacaoAtrasada.operacoesPorTick) {
+        descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID,
+                           "temporizador");
+    }
+}
+
+// ---------------- journal de metadados (write-ahead) ----------------
+// cada operação vira uma transação com as atualizações do mapa de blocos (disk[]), do diretório
+// e do bloco índice; a transação vai para o log antes de tocar o local definitivo, e a recuperação
+// reaplica somente as transações cujo bloco de commit chegou ao dispositivo.
+// o simulador não intercepta cada escrita em disk[]: a transação é montada comparando o estado
+// antes e depois da operação
+constexpr int JOURNAL_DESATIVADO = 0;
+constexpr int JOURNAL_ORDERED = 1;    // dados gravados antes do commit dos metadados
+constexpr int JOURNAL_WRITEBACK = 2;  // dados gravados só no checkpoint
+constexpr int CAPACIDADE_LOG = 32;      // blocos no log antes de forçar um checkpoint
+
+// estado visto pelo journal: todos os arquivos num único diretório (File::metodo diz o método)
+struct EstadoDisco {
+    vector<int> disk;
+    unordered_map<string, File> arquivos;
+};
+
+struct RegistroJournal {
+    bool diretorio = false;  // false: entrada do mapa de blocos; true: entrada de diretório
+    int bloco = -1;
+    int valor = BLOCO_LIVRE;
+    bool removido = false;
+    File file;               // no método indexado inclui o conteúdo do bloco índice (dataBlocks)
+};
+
+struct Transacao {
+    long long id = 0;
+    vector<RegistroJournal> registros;
+    vector<int> blocosDados;  // blocos recém-alocados, cujo conteúdo também precisa ir para o disco
+    long long submissao = 0;  // relógio do dispositivo quando a operação terminou
+};
+
+enum TipoEscrita { ESCRITA_HOME, ESCRITA_DADOS, ESCRITA_LOG, ESCRITA_COMMIT, ESCRITA_TRUNCAR };
+
+struct EscritaDispositivo {
+    TipoEscrita tipo = ESCRITA_HOME;
+    long long transacao = 0;
+    RegistroJournal registro = {}; // ESCRITA_HOME e ESCRITA_LOG
+    int bloco = -1;           // ESCRITA_DADOS
+};
+
+// o que sobrevive a uma queda: metadados no local definitivo, o log e, por bloco, qual
+// transação alocou o bloco e qual transação gravou o conteúdo dele por último
+struct Dispositivo {
+    EstadoDisco home;
+    vector<long long> alocadoEm;
+    vector<long long> dadoGravadoEm;
+    vector<pair<long long, RegistroJournal>> log;
+    long long ultimoCommit = 0;
+};
+
+struct Journal {
+    int modo = JOURNAL_DESATIVADO;
+    int tamanhoGrupo = 4;          // transações por commit em grupo
+    EstadoDisco anterior;          // estado em memória após a última transação
+    vector<Transacao> grupo;       // aguardando o commit em grupo
+    vector<Transacao> noLog;       // confirmadas, ainda não aplicadas ao local definitivo
+    int blocosNoLog = 0;
+    long long proximaTransacao = 1;
+    long long relogio = 0;         // ms
+    Dispositivo dispositivo;
+    vector<EscritaDispositivo>* gravacao = nullptr; // teste de falhas: guarda a sequência de escritas
+    long long transacoes = 0;
+    long long commits = 0;
+    long long checkpoints = 0;
+    long long blocosEscritos = 0;
+    long long blocosSemJournal = 0; // o que as transações confirmadas gravariam sem journal
+    long long latenciaTotal = 0;    // soma, por transação, do fim da operação até ela ser durável
+};
+
+Journal journal;
+
+string nomeDoModoJournal(int modo) {
+    switch (modo) {
+        case JOURNAL_DESATIVADO: return "desativado";
+        case JOURNAL_ORDERED: return "ordered";
+        case JOURNAL_WRITEBACK: return "writeback";
+        default: return "?";
+    }
+}
+
+EstadoDisco capturarEstado(const vector<int>& disk,
+                           const unordered_map<string, File>& filesContiguous,
+                           const unordered_map<string, File>& filesEncadeados,
+                           const unordered_map<string, File>& filesIndexados,
+                           const unordered_map<string, File>& filesExtents) {
+    EstadoDisco estado;
+    estado.disk = disk;
+    for (const auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+        for (const auto& [nome, file] : *files) estado.arquivos[nome] = file;
+    }
+    return estado;
+}
+
+bool mesmoArquivo(const File& a, const File& b) {
+    return a.metodo == b.metodo && a.startBlock == b.startBlock && a.indexBlock == b.indexBlock &&
+           a.size == b.size && a.sizeBytes == b.sizeBytes && a.dataBlocks == b.dataBlocks &&
+           a.extents == b.extents;
+}
+
+// diferença entre dois estados: primeiro o mapa de blocos, depois as entradas de diretório
+Transacao montarTransacao(const EstadoDisco& antes, const EstadoDisco& depois) {
+    Transacao tx;
+    for (size_t i = 0; i < depois.disk.size(); ++i) {
+        if (i < antes.disk.size() && antes.disk[i] == depois.disk[i]) continue;
+        RegistroJournal registro;
+        registro.bloco = static_cast<int>(i);
+        registro.valor = depois.disk[i];
+        tx.registros.push_back(registro);
+        bool estavaLivre = i >= antes.disk.size() || antes.disk[i] == BLOCO_LIVRE;
+        if (estavaLivre && depois.disk[i] != BLOCO_LIVRE) tx.blocosDados.push_back(static_cast<int>(i));
+    }
+    for (const auto& [nome, file] : depois.arquivos) {
+        auto it = antes.arquivos.find(nome);
+        if (it != antes.arquivos.end() && mesmoArquivo(it->second, file)) continue;
+        RegistroJournal registro;
+        registro.diretorio = true;
+        registro.file = file;
+        tx.registros.push_back(registro);
+    }
+    for (const auto& [nome, file] : antes.arquivos) {
+        if (depois.arquivos.count(nome)) continue;
+        RegistroJournal registro;
+        registro.diretorio = true;
+        registro.removido = true;
+        registro.file.name = nome;
+        tx.registros.push_back(registro);
+    }
+    return tx;
+}
+
+// uma entrada de diretório do método indexado também reescreve o bloco índice
+int blocosDoRegistro(const RegistroJournal& registro) {
+    bool comIndice = registro.diretorio && !registro.removido && registro.file.metodo == METODO_INDEXADO;
+    return comIndice ? 2 : 1;
+}
+
+void aplicarNoHome(Dispositivo& dispositivo, long long transacao, const RegistroJournal& registro) {
+    EstadoDisco& home = dispositivo.home;
+    if (registro.diretorio) {
+        if (registro.removido) home.arquivos.erase(registro.file.name);
+        else home.arquivos[registro.file.name] = registro.file;
+        return;
+    }
+    if (home.disk[registro.bloco] == BLOCO_LIVRE && registro.valor != BLOCO_LIVRE) {
+        dispositivo.alocadoEm[registro.bloco] = transacao;
+    }
+    home.disk[registro.bloco] = registro.valor;
+}
+
+void aplicarEscrita(Dispositivo& dispositivo, const EscritaDispositivo& escrita) {
+    switch (escrita.tipo) {
+        case ESCRITA_HOME: aplicarNoHome(dispositivo, escrita.transacao, escrita.registro); break;
+        case ESCRITA_DADOS: dispositivo.dadoGravadoEm[escrita.bloco] = escrita.transacao; break;
+        case ESCRITA_LOG: dispositivo.log.push_back({escrita.transacao, escrita.registro}); break;
+        case ESCRITA_COMMIT: dispositivo.ultimoCommit = escrita.transacao; break;
+        case ESCRITA_TRUNCAR: dispositivo.log.clear(); break;
+    }
+}
+
+// blocos que a transação gravaria indo direto ao local definitivo
+int blocosSemJournal(const Transacao& tx) {
+    int blocos = static_cast<int>(tx.blocosDados.size());
+    for (const RegistroJournal& registro : tx.registros) blocos += blocosDoRegistro(registro);
+    return blocos;
+}
+
+// grava no dispositivo e contabiliza o custo pelo modeloTempo: log é sequencial, local definitivo e dados
+// são aleatórios
+void escreverNoDispositivo(Journal& j, const EscritaDispositivo& escrita) {
+    int blocos = 1;
+    long long custo = 0;
+    switch (escrita.tipo) {
+        case ESCRITA_HOME:
+            blocos = blocosDoRegistro(escrita.registro);
+            custo = blocos * modeloTempo.aleatorio;
+            break;
+        case ESCRITA_DADOS:
+            custo = modeloTempo.aleatorio;
+            break;
+        case ESCRITA_LOG:
+            blocos = blocosDoRegistro(escrita.registro);
+            custo = blocos * modeloTempo.sequencial;
+            break;
+        case ESCRITA_COMMIT: // bloco descritor + bloco de commit, seguidos de uma barreira
+            blocos = 2;
+            custo = blocos * modeloTempo.sequencial + modeloTempo.barreira;
+            break;
+        case ESCRITA_TRUNCAR: // superbloco do log
+            custo = modeloTempo.sequencial + modeloTempo.barreira;
+            break;
+    }
+    j.blocosEscritos += blocos;
+    j.relogio += custo;
+    aplicarEscrita(j.dispositivo, escrita);
+    if (j.gravacao) j.gravacao->push_back(escrita);
+}
+
+void escreverRegistro(Journal& j, TipoEscrita tipo, long long transacao, const RegistroJournal& registro) {
+    EscritaDispositivo escrita{tipo};
+    escrita.transacao = transacao;
+    escrita.registro = registro;
+    escreverNoDispositivo(j, escrita);
+}
+
+void escreverDados(Journal& j, long long transacao, int bloco) {
+    EscritaDispositivo escrita{ESCRITA_DADOS};
+    escrita.transacao = transacao;
+    escrita.bloco = bloco;
+    escreverNoDispositivo(j, escrita);
+}
+
+void iniciarJournal(Journal& j, int modo, const EstadoDisco& estado) {
+    int tamanhoGrupo = j.tamanhoGrupo;
+    j = Journal();
+    j.modo = modo;
+    j.tamanhoGrupo = tamanhoGrupo;
+    j.anterior = estado;
+    j.dispositivo.home = estado;
+    j.dispositivo.alocadoEm.assign(estado.disk.size(), 0);
+    j.dispositivo.dadoGravadoEm.assign(estado.disk.size(), 0);
+}
+
+// aplica no local definitivo tudo que já está confirmado no log e libera o log
+void checkpointJournal(Journal& j) {
+    if (j.noLog.empty()) return;
+    for (const Transacao& tx : j.noLog) {
+        for (const RegistroJournal& registro : tx.registros) escreverRegistro(j, ESCRITA_HOME, tx.id, registro);
+    }
+    if (j.modo == JOURNAL_WRITEBACK) {
+        for (const Transacao& tx : j.noLog) {
+            for (int bloco : tx.blocosDados) escreverDados(j, tx.id, bloco);
+        }
+    }
+    escreverNoDispositivo(j, EscritaDispositivo{ESCRITA_TRUNCAR});
+    j.noLog.clear();
+    j.blocosNoLog = 0;
+    j.checkpoints++;
+}
+
+// commit em grupo: um único bloco de commit (e uma barreira) torna duráveis todas as transações do grupo
+void commitGrupo(Journal& j) {
+    if (j.grupo.empty()) return;
+    if (j.modo == JOURNAL_ORDERED) {
+        for (const Transacao& tx : j.grupo) {
+            for (int bloco : tx.blocosDados) escreverDados(j, tx.id, bloco);
+        }
+    }
+    for (const Transacao& tx : j.grupo) {
+        for (const RegistroJournal& registro : tx.registros) {
+            escreverRegistro(j, ESCRITA_LOG, tx.id, registro);
+            j.blocosNoLog += blocosDoRegistro(registro);
+        }
+    }
+    EscritaDispositivo commit{ESCRITA_COMMIT};
+    commit.transacao = j.grupo.back().id;
+    escreverNoDispositivo(j, commit);
+    j.commits++;
+    for (Transacao& tx : j.grupo) {
+        j.latenciaTotal += j.relogio - tx.submissao;
+        j.blocosSemJournal += blocosSemJournal(tx);
+        j.noLog.push_back(move(tx));
+    }
+    j.grupo.clear();
+    if (j.blocosNoLog >= CAPACIDADE_LOG) checkpointJournal(j);
+}
+
+void submeterTransacao(Journal& j, Transacao tx) {
+    tx.id = j.proximaTransacao++;
+    tx.submissao = j.relogio;
+    j.transacoes++;
+
+    if (j.modo == JOURNAL_DESATIVADO) {
+        // sem journal as escritas vão direto ao local definitivo, na ordem em que o alocador as faz:
+        // ponteiros/mapa de blocos, conteúdo e só no fim a entrada de diretório
+        for (const RegistroJournal& registro : tx.registros) {
+            if (!registro.diretorio) escreverRegistro(j, ESCRITA_HOME, tx.id, registro);
+        }
+        for (int bloco : tx.blocosDados) escreverDados(j, tx.id, bloco);
+        for (const RegistroJournal& registro : tx.registros) {
+            if (registro.diretorio) escreverRegistro(j, ESCRITA_HOME, tx.id, registro);
+        }
+        j.latenciaTotal += j.relogio - tx.submissao;
+        j.blocosSemJournal += blocosSemJournal(tx);
+        return;
+    }
+    j.grupo.push_back(move(tx));
+    if ((int)j.grupo.size() >= j.tamanhoGrupo) commitGrupo(j);
+}
+
+// registra como transação tudo o que mudou desde a transação anterior
+void registrarTransacao(Journal& j, EstadoDisco atual) {
+    Transacao tx = montarTransacao(j.anterior, atual);
+    j.anterior = move(atual);
+    if (!tx.registros.empty()) submeterTransacao(j, move(tx));
+}
+
+// recuperação após uma queda: reaplica as transações confirmadas que ainda estão no log
+Dispositivo recuperarDispositivo(Dispositivo dispositivo) {
+    for (const auto& [transacao, registro] : dispositivo.log) {
+        if (transacao <= dispositivo.ultimoCommit) aplicarNoHome(dispositivo, transacao, registro);
+    }
+    dispositivo.log.clear();
+    return dispositivo;
+}
+
+struct ResultadoVerificacao {
+    int orfaos = 0;              // blocos ocupados que nenhum arquivo referencia
+    int referenciasInvalidas = 0; // blocos livres referenciados ou referenciados por mais de um arquivo
+    int arquivosComDadosAntigos = 0;
+};
+
+ResultadoVerificacao verificarDispositivo(const Dispositivo& dispositivo) {
+    ResultadoVerificacao resultado;
+    const vector<int>& disk = dispositivo.home.disk;
+    vector<int> donos(disk.size(), 0);
+    for (const auto& [nome, file] : dispositivo.home.arquivos) {
+        vector<int> blocos = blocosDoArquivo(file);
+        bool dadosAntigos = false;
+        for (int bloco : blocos) {
+            if (bloco < 0 || bloco >= (int)disk.size() || disk[bloco] == BLOCO_LIVRE) {
+                resultado.referenciasInvalidas++;
+                continue;
+            }
+            donos[bloco]++;
+            if (dispositivo.dadoGravadoEm[bloco] < dispositivo.alocadoEm[bloco]) dadosAntigos = true;
+        }
+        if (file.metodo == METODO_INDEXADO) {
+            if (file.indexBlock < 0 || file.indexBlock >= (int)disk.size() || disk[file.indexBlock] == BLOCO_LIVRE) {
+                resultado.referenciasInvalidas++;
+            } else {
+                donos[file.indexBlock]++;
+            }
+        }
+        if (dadosAntigos) resultado.arquivosComDadosAntigos++;
+    }
+    for (size_t i = 0; i < disk.size(); ++i) {
+        if (disk[i] != BLOCO_LIVRE && donos[i] == 0) resultado.orfaos++;
+        if (donos[i] > 1) resultado.referenciasInvalidas++;
+    }
+    return resultado;
+}
+
+bool mesmoEstado(const EstadoDisco& a, const EstadoDisco& b) {
+    if (a.disk != b.disk || a.arquivos.size() != b.arquivos.size()) return false;
+    for (const auto& [nome, file] : a.arquivos) {
+        auto it = b.arquivos.find(nome);
+        if (it == b.arquivos.end() || !mesmoArquivo(file, it->second)) return false;
+    }
+    return true;
+}
+
+// teste de injeção de falhas: roda a mesma carga com e sem journal, derruba o dispositivo depois
+// de cada escrita, recupera e verifica se os metadados voltaram a uma fronteira de transação
+void testarRecuperacaoJournal(int tamanhoGrupo) {
+    constexpr int BLOCOS_TESTE = 48;
+    constexpr int OPERACOES_TESTE = 40;
+
+    cout << "\nInjeção de falhas: " << OPERACOES_TESTE << " operações num disco de " << BLOCOS_TESTE
+         << " blocos, queda após cada escrita no dispositivo (grupo de " << tamanhoGrupo << " transações)\n";
+    cout << left << setw(12) << "Modo" << right << setw(8) << "Quedas" << setw(14) << "Inconsist."
+         << setw(16) << "Não atômicas" << setw(14) << "Dados antigos" << setw(10) << "Blocos"
+         << setw(10) << "Amplif." << setw(15) << "Latência (ms)" << "\n";
+
+    for (int modo : {JOURNAL_DESATIVADO, JOURNAL_ORDERED, JOURNAL_WRITEBACK}) {
+        vector<int> disk(BLOCOS_TESTE, BLOCO_LIVRE);
+        unordered_map<string, File> filesContiguous, filesEncadeados, filesIndexados, filesExtents;
+        unordered_map<string, tuple<int, int>> tabela;
+        int fileID = 0;
+
+        Journal j;
+        j.tamanhoGrupo = tamanhoGrupo;
+        iniciarJournal(j, modo, capturarEstado(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents));
+        Dispositivo inicial = j.dispositivo;
+        vector<EscritaDispositivo> escritas;
+        j.gravacao = &escritas;
+        vector<EstadoDisco> fronteiras = {j.anterior};
+
+        mt19937 rng(2024); // mesma carga para os três modos
+        vector<string> nomes;
+        for (int op = 0; op < OPERACOES_TESTE; ++op) {
+            int sorteio = rng() % 10;
+            if (nomes.empty() || sorteio < 5) {
+                string nome = "t" + to_string(op);
+                int bytes = 8 + rng() % 33;
+                int metodo = METODO_CONTIGUO + rng() % 4;
+                if (alocarArquivoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela,
+                                       metodo, nome, bytes, (bytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO,
+                                       fileID) == ALOCACAO_OK) {
+                    nomes.push_back(nome);
+                }
+            } else if (sorteio < 8) {
+                alocarExtensaoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela,
+                                    nomes[rng() % nomes.size()], 8 + rng() % 17);
+            } else {
+                size_t i = rng() % nomes.size();
+                removerArquivo(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela, nomes[i]);
+                nomes.erase(nomes.begin() + i);
+            }
+            EstadoDisco atual = capturarEstado(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+            fronteiras.push_back(atual);
+            registrarTransacao(j, move(atual));
+        }
+        commitGrupo(j);
+        checkpointJournal(j);
+
+        int inconsistentes = 0, naoAtomicas = 0, comDadosAntigos = 0;
+        Dispositivo dispositivo = inicial;
+        for (size_t queda = 0; queda <= escritas.size(); ++queda) {
+            if (queda > 0) aplicarEscrita(dispositivo, escritas[queda - 1]);
+            Dispositivo recuperado = recuperarDispositivo(dispositivo);
+            ResultadoVerificacao v = verificarDispositivo(recuperado);
+            if (v.orfaos > 0 || v.referenciasInvalidas > 0) inconsistentes++;
+            if (v.arquivosComDadosAntigos > 0) comDadosAntigos++;
+            bool fronteira = any_of(fronteiras.begin(), fronteiras.end(),
+                                    [&](const EstadoDisco& e) { return mesmoEstado(e, recuperado.home); });
+            if (!fronteira) naoAtomicas++;
+        }
+
+        double amplificacao = j.blocosSemJournal ? (double)j.blocosEscritos / j.blocosSemJournal : 0.0;
+        double latencia = j.transacoes ? (double)j.latenciaTotal / j.transacoes : 0.0;
+        cout << left << setw(12) << nomeDoModoJournal(modo) << right << setw(8) << escritas.size() + 1
+             << setw(14) << inconsistentes << setw(14) << naoAtomicas << setw(14) << comDadosAntigos
+             << setw(10) << j.blocosEscritos << fixed << setprecision(2) << setw(10) << amplificacao
+             << setprecision(1) << setw(14) << latencia << "\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+    cout << "Inconsist.: metadados com blocos órfãos ou referências inválidas após a recuperação.\n"
+         << "Não atômicas: estado recuperado que não corresponde a nenhuma fronteira de transação.\n"
+         << "Dados antigos: arquivos confirmados apontando para blocos cujo conteúdo novo não foi gravado.\n";
+}
+
+void displayEstatisticasJournal(const Journal& j) {
+    if (j.modo == JOURNAL_DESATIVADO) return;
+    double amplificacao = j.blocosSemJournal ? (double)j.blocosEscritos / j.blocosSemJournal : 0.0;
+    double latencia = j.transacoes - (long long)j.grupo.size() > 0
+                    ? (double)j.latenciaTotal / (j.transacoes - j.grupo.size()) : 0.0;
+    cout << "Journal (" << nomeDoModoJournal(j.modo) << ", grupo de " << j.tamanhoGrupo << "): "
+         << j.transacoes << " transações | " << j.commits << " commits | " << j.checkpoints << " checkpoints | "
+         << j.grupo.size() << " aguardando commit | " << j.blocosEscritos << " blocos gravados ("
+         << fixed << setprecision(2) << amplificacao << "x sem journal) | latência média "
+         << setprecision(1) << latencia << " ms" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+void configurarJournalMenu(const vector<int>& disk,
+                           const unordered_map<string, File>& filesContiguous,
+                           const unordered_map<string, File>& filesEncadeados,
+                           const unordered_map<string, File>& filesIndexados,
+                           const unordered_map<string, File>& filesExtents) {
+    displayEstatisticasJournal(journal);
+
+    int opcao;
+    cout << "Journal de metadados:\n0. Desativado\n1. Ordered (dados antes do commit)\n"
+         << "2. Writeback (dados no checkpoint)\n3. Testar recuperação com injeção de falhas\n";
+    cin >> opcao;
+    if (cin.fail() || opcao < 0 || opcao > 3) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Opção inválida!" << endl;
+        return;
+    }
+    if (opcao == 3) {
+        testarRecuperacaoJournal(journal.tamanhoGrupo);
+        return;
+    }
+
+    commitGrupo(journal);
+    checkpointJournal(journal);
+    if (opcao == JOURNAL_DESATIVADO) {
+        iniciarJournal(journal, JOURNAL_DESATIVADO, EstadoDisco());
+        cout << "Journal desativado." << endl;
+        return;
+    }
+
+    int tamanhoGrupo;
+    cout << "Transações por commit em grupo: ";
+    cin >> tamanhoGrupo;
+    if (cin.fail() || tamanhoGrupo <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Tamanho inválido!" << endl;
+        return;
+    }
+    journal.tamanhoGrupo = tamanhoGrupo;
+    iniciarJournal(journal, opcao,
+                   capturarEstado(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents));
+    cout << "Journal " << nomeDoModoJournal(opcao) << " ativado (commit a cada " << tamanhoGrupo
+         << " transações)." << endl;
+}
+
+// ---------------- verificação de consistência (fsck) ----------------
+// uma passada pelos arquivos marca o dono de cada bloco (contagem + arquivo preferido) e confere
+// o valor gravado em disk[]; uma passada pelos blocos acha órfãos e blocos compartilhados.
+// as duas passadas são lineares e, em discos grandes, divididas entre threads
+constexpr size_t LIMIAR_FSCK_PARALELO = 1 << 16; // blocos; abaixo disso uma thread basta
+
+enum TipoProblemaFsck {
+    FSCK_BLOCO_FORA_DO_DISCO,
+    FSCK_BLOCO_COMPARTILHADO,
+    FSCK_BLOCO_ORFAO,
+    FSCK_REFERENCIA_LIVRE,
+    FSCK_VALOR_INCORRETO,
+    FSCK_CADEIA_QUEBRADA,
+    FSCK_INDICE_INCORRETO,
+    FSCK_TAMANHO_INCORRETO,
+    FSCK_NOME_DUPLICADO,
+    FSCK_TABELA_DIVERGENTE,
+    FSCK_TABELA_SEM_ARQUIVO
+};
+
+struct ProblemaFsck {
+    TipoProblemaFsck tipo;
+    string arquivo;
+    int bloco = -1;
+};
+
+struct ResultadoFsck {
+    vector<ProblemaFsck> problemas;
+    vector<const File*> arquivos;   // ordenados por nome; o índice aqui é o "id" do dono
+    vector<int> donoDoBloco;        // arquivo que fica com o bloco no reparo (-1: nenhum)
+    vector<bool> descartar;         // arquivos que o reparo precisa tirar do diretório
+    int threads = 1;
+};
+
+string descricaoProblemaFsck(TipoProblemaFsck tipo) {
+    switch (tipo) {
+        case FSCK_BLOCO_FORA_DO_DISCO: return "referência a bloco fora do disco";
+        case FSCK_BLOCO_COMPARTILHADO: return "bloco referenciado por mais de um arquivo";
+        case FSCK_BLOCO_ORFAO: return "bloco ocupado sem dono";
+        case FSCK_REFERENCIA_LIVRE: return "arquivo referencia bloco livre";
+        case FSCK_VALOR_INCORRETO: return "valor do bloco não aponta para o início do arquivo";
+        case FSCK_CADEIA_QUEBRADA: return "cadeia não segue dataBlocks ou não termina em FIM_CADEIA";
+        case FSCK_INDICE_INCORRETO: return "bloco índice não corresponde a dataBlocks";
+        case FSCK_TAMANHO_INCORRETO: return "tamanho em blocos diferente da lista de blocos";
+        case FSCK_NOME_DUPLICADO: return "mesmo nome em mais de um método";
+        case FSCK_TABELA_DIVERGENTE: return "tabela de diretório diverge do arquivo";
+        case FSCK_TABELA_SEM_ARQUIVO: return "entrada da tabela de diretório sem arquivo";
+    }
+    return "?";
+}
+
+// divide [0, total) em faixas e roda funcao(inicio, fim, faixa) em cada uma
+template <typename Funcao>
+void executarEmFaixas(int threads, size_t total, Funcao funcao) {
+    if (threads <= 1) {
+        funcao(size_t(0), total, 0);
+        return;
+    }
+    vector<thread> trabalhadores;
+    size_t passo = (total + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        size_t inicio = min(total, t * passo);
+        size_t fim = min(total, inicio + passo);
+        trabalhadores.emplace_back(funcao, inicio, fim, t);
+    }
+    for (thread& trabalhador : trabalhadores) trabalhador.join();
+}
+
+// entrada da tabela de diretório que cada método grava ao alocar
+tuple<int, int> entradaEsperadaTabela(const File& file) {
+    if (file.metodo == METODO_INDEXADO) return make_tuple(file.indexBlock, file.size);
+    if (file.metodo == METODO_ENCADEADO && !file.dataBlocks.empty()) return make_tuple(file.dataBlocks.front(), file.size);
+    return make_tuple(file.startBlock, file.size);
+}
+
+// valor que o bloco na posição pos do arquivo deve ter em disk[]
+int valorEsperadoBloco(const File& file, const vector<int>& blocos, size_t pos) {
+    switch (file.metodo) {
+        case METODO_ENCADEADO: return pos + 1 < blocos.size() ? blocos[pos + 1] : FIM_CADEIA;
+        case METODO_INDEXADO: return file.indexBlock;
+        default: return file.startBlock;
+    }
+}
+
+TipoProblemaFsck problemaDeValor(const File& file) {
+    if (file.metodo == METODO_ENCADEADO) return FSCK_CADEIA_QUEBRADA;
+    if (file.metodo == METODO_INDEXADO) return FSCK_INDICE_INCORRETO;
+    return FSCK_VALOR_INCORRETO;
+}
+
+ResultadoFsck executarFsck(const vector<int>& disk,
+                           const unordered_map<string, File>& filesContiguous,
+                           const unordered_map<string, File>& filesEncadeados,
+                           const unordered_map<string, File>& filesIndexados,
+                           const unordered_map<string, File>& filesExtents,
+                           const unordered_map<string, tuple<int, int>>& tabelaDiretorio) {
+    ResultadoFsck resultado;
+    for (const auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+        for (const auto& [nome, file] : *files) resultado.arquivos.push_back(&file);
+    }
+    sort(resultado.arquivos.begin(), resultado.arquivos.end(), [](const File* a, const File* b) {
+        return a->name != b->name ? a->name < b->name : a->metodo < b->metodo;
+    });
+    resultado.descartar.assign(resultado.arquivos.size(), false);
+    for (size_t i = 1; i < resultado.arquivos.size(); ++i) {
+        if (resultado.arquivos[i]->name == resultado.arquivos[i - 1]->name) {
+            resultado.problemas.push_back({FSCK_NOME_DUPLICADO, resultado.arquivos[i]->name});
+            resultado.descartar[i] = true;
+        }
+    }
+
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    resultado.threads = disk.size() >= LIMIAR_FSCK_PARALELO ? static_cast<int>(hardware) : 1;
+
+    const int numBlocos = static_cast<int>(disk.size());
+    vector<atomic<int>> referencias(disk.size());
+    vector<atomic<int>> dono(disk.size());
+    for (int i = 0; i < numBlocos; ++i) {
+        referencias[i].store(0, memory_order_relaxed);
+        dono[i].store(INT_MAX, memory_order_relaxed);
+    }
+    vector<vector<ProblemaFsck>> problemasPorFaixa(resultado.threads);
+    vector<char> foraDoDisco(resultado.arquivos.size(), 0);
+
+    // passada 1: arquivos
+    executarEmFaixas(resultado.threads, resultado.arquivos.size(), [&](size_t inicio, size_t fim, int faixa) {
+        vector<ProblemaFsck>& problemas = problemasPorFaixa[faixa];
+        for (size_t f = inicio; f < fim; ++f) {
+            const File& file = *resultado.arquivos[f];
+            vector<int> blocos = blocosDoArquivo(file);
+            if ((int)blocos.size() != file.size) problemas.push_back({FSCK_TAMANHO_INCORRETO, file.name});
+            if (file.metodo == METODO_ENCADEADO && (blocos.empty() || blocos[0] != file.startBlock))
+                problemas.push_back({FSCK_CADEIA_QUEBRADA, file.name, file.startBlock});
+            if (file.metodo == METODO_INDEXADO && (int)blocos.size() > MAX_ENTRADAS_INDICE)
+                problemas.push_back({FSCK_INDICE_INCORRETO, file.name, file.indexBlock});
+
+            auto reivindicar = [&](int bloco, int esperado) {
+                if (bloco < 0 || bloco >= numBlocos) {
+                    problemas.push_back({FSCK_BLOCO_FORA_DO_DISCO, file.name, bloco});
+                    foraDoDisco[f] = 1;
+                    return;
+                }
+                // o dono preferido é o arquivo com que disk[] concorda; entre eles, o de menor índice
+                referencias[bloco].fetch_add(1, memory_order_relaxed);
+                int chave = static_cast<int>(disk[bloco] == esperado ? f : f + resultado.arquivos.size());
+                int atual = dono[bloco].load(memory_order_relaxed);
+                while (chave < atual && !dono[bloco].compare_exchange_weak(atual, chave, memory_order_relaxed)) {
+                }
+                if (disk[bloco] == BLOCO_LIVRE) problemas.push_back({FSCK_REFERENCIA_LIVRE, file.name, bloco});
+                else if (disk[bloco] != esperado) problemas.push_back({problemaDeValor(file), file.name, bloco});
+            };
+            for (size_t pos = 0; pos < blocos.size(); ++pos) {
+                reivindicar(blocos[pos], valorEsperadoBloco(file, blocos, pos));
+            }
+            if (file.metodo == METODO_INDEXADO) reivindicar(file.indexBlock, FIM_CADEIA);
+        }
+    });
+
+    // passada 2: blocos
+    vector<vector<ProblemaFsck>> problemasDosBlocos(resultado.threads);
+    resultado.donoDoBloco.assign(disk.size(), -1);
+    executarEmFaixas(resultado.threads, disk.size(), [&](size_t inicio, size_t fim, int faixa) {
+        for (size_t b = inicio; b < fim; ++b) {
+            int quantos = referencias[b].load(memory_order_relaxed);
+            if (quantos == 0) {
+                if (disk[b] != BLOCO_LIVRE) problemasDosBlocos[faixa].push_back({FSCK_BLOCO_ORFAO, "", (int)b});
+                continue;
+            }
+            int vencedor = dono[b].load(memory_order_relaxed) % static_cast<int>(resultado.arquivos.size());
+            resultado.donoDoBloco[b] = vencedor;
+            if (quantos > 1) {
+                problemasDosBlocos[faixa].push_back(
+                    {FSCK_BLOCO_COMPARTILHADO, resultado.arquivos[vencedor]->name, (int)b});
+            }
+        }
+    });
+    for (int t = 0; t < resultado.threads; ++t) {
+        resultado.problemas.insert(resultado.problemas.end(), problemasPorFaixa[t].begin(), problemasPorFaixa[t].end());
+        resultado.problemas.insert(resultado.problemas.end(), problemasDosBlocos[t].begin(), problemasDosBlocos[t].end());
+    }
+
+    // um arquivo que perdeu algum bloco compartilhado para outro dono é descartado pelo reparo
+    for (size_t f = 0; f < resultado.arquivos.size(); ++f) {
+        const File& file = *resultado.arquivos[f];
+        if (foraDoDisco[f]) resultado.descartar[f] = true;
+        vector<int> blocos = blocosDoArquivo(file);
+        if (file.metodo == METODO_INDEXADO) blocos.push_back(file.indexBlock);
+        for (int bloco : blocos) {
+            if (bloco >= 0 && bloco < numBlocos && resultado.donoDoBloco[bloco] != (int)f) resultado.descartar[f] = true;
+        }
+    }
+
+    // tabela de diretório
+    for (size_t f = 0; f < resultado.arquivos.size(); ++f) {
+        const File& file = *resultado.arquivos[f];
+        auto it = tabelaDiretorio.find(file.name);
+        if (it == tabelaDiretorio.end() || it->second != entradaEsperadaTabela(file))
+            resultado.problemas.push_back({FSCK_TABELA_DIVERGENTE, file.name});
+    }
+    for (const auto& [nome, entrada] : tabelaDiretorio) {
+        bool temArquivo = filesContiguous.count(nome) || filesEncadeados.count(nome) ||
+                          filesIndexados.count(nome) || filesExtents.count(nome);
+        // arquivo novo que ainda está só no buffer da alocação atrasada
+        auto itBuffer = alocacaoAtrasada.buffers.find(nome);
+        bool pendente = itBuffer != alocacaoAtrasada.buffers.end() && itBuffer->second.novo &&
+                        entrada == make_tuple(-1, 0);
+        if (!temArquivo && !pendente) resultado.problemas.push_back({FSCK_TABELA_SEM_ARQUIVO, nome});
+    }
+    return resultado;
+}
+
+// reparo: descarta os arquivos irrecuperáveis, reescreve disk[] e a tabela a partir dos arquivos que
+// ficaram e libera os blocos sem dono. Retorna quantos blocos foram alterados
+int repararFsck(const ResultadoFsck& resultado,
+                vector<int>& disk,
+                unordered_map<string, File>& filesContiguous,
+                unordered_map<string, File>& filesEncadeados,
+                unordered_map<string, File>& filesIndexados,
+                unordered_map<string, File>& filesExtents,
+                unordered_map<string, tuple<int, int>>& tabelaDiretorio) {
+    unordered_map<string, File>* mapas[] = {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents};
+
+    // copia os nomes/métodos antes de apagar: os ponteiros do resultado apontam para dentro dos maps
+    vector<pair<string, int>> descartados;
+    for (size_t f = 0; f < resultado.arquivos.size(); ++f) {
+        if (resultado.descartar[f]) descartados.push_back({resultado.arquivos[f]->name, resultado.arquivos[f]->metodo});
+    }
+    for (const auto& [nome, metodo] : descartados) {
+        mapas[metodo - 1]->erase(nome);
+        cout << "  arquivo " << nome << " (" << nomeDoMetodo(metodo) << ") descartado" << endl;
+    }
+
+    vector<bool> emUso(disk.size(), false);
+    int alterados = 0;
+    auto gravar = [&](int bloco, int valor) {
+        emUso[bloco] = true;
+        if (disk[bloco] != valor) {
+            disk[bloco] = valor;
+            alterados++;
+        }
+    };
+    for (auto* files : mapas) {
+        for (auto& [nome, file] : *files) {
+            vector<int> blocos = blocosDoArquivo(file);
+            if (file.size != (int)blocos.size()) {
+                file.size = static_cast<int>(blocos.size());
+                file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+            }
+            if (file.metodo == METODO_ENCADEADO && !blocos.empty()) file.startBlock = blocos[0];
+            for (size_t pos = 0; pos < blocos.size(); ++pos) gravar(blocos[pos], valorEsperadoBloco(file, blocos, pos));
+            if (file.metodo == METODO_INDEXADO) gravar(file.indexBlock, FIM_CADEIA);
+            tabelaDiretorio[nome] = entradaEsperadaTabela(file);
+        }
+    }
+    for (size_t b = 0; b < disk.size(); ++b) {
+        if (!emUso[b] && disk[b] != BLOCO_LIVRE) {
+            disk[b] = BLOCO_LIVRE;
+            invalidarBlocoCache(cacheBlocos, static_cast<int>(b));
+            alterados++;
+        }
+    }
+    for (auto it = tabelaDiretorio.begin(); it != tabelaDiretorio.end();) {
+        const string& nome = it->first;
+        bool temArquivo = filesContiguous.count(nome) || filesEncadeados.count(nome) ||
+                          filesIndexados.count(nome) || filesExtents.count(nome);
+        auto itBuffer = alocacaoAtrasada.buffers.find(nome);
+        bool pendente = itBuffer != alocacaoAtrasada.buffers.end() && itBuffer->second.novo;
+        if (!temArquivo && !pendente) it = tabelaDiretorio.erase(it);
+        else ++it;
+    }
+    return alterados;
+}
+
+void displayResultadoFsck(const ResultadoFsck& resultado, size_t numBlocos) {
+    cout << "fsck: " << numBlocos << " blocos e " << resultado.arquivos.size() << " arquivo(s) verificados com "
+         << resultado.threads << " thread(s)" << endl;
+    if (resultado.problemas.empty()) {
+        cout << "Nenhuma inconsistência encontrada." << endl;
+        return;
+    }
+    for (const ProblemaFsck& problema : resultado.problemas) {
+        cout << "  - " << descricaoProblemaFsck(problema.tipo);
+        if (!problema.arquivo.empty()) cout << " | arquivo " << problema.arquivo;
+        if (problema.bloco >= 0) cout << " | bloco " << problema.bloco;
+        cout << endl;
+    }
+    cout << resultado.problemas.size() << " inconsistência(s) encontrada(s)." << endl;
+}
+
+void verificarConsistenciaMenu(vector<int>& disk,
+                               unordered_map<string, File>& filesContiguous,
+                               unordered_map<string, File>& filesEncadeados,
+                               unordered_map<string, File>& filesIndexados,
+                               unordered_map<string, File>& filesExtents) {
+    ResultadoFsck resultado = executarFsck(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                           tabelaDiretorio);
+    displayResultadoFsck(resultado, disk.size());
+
+    // as métricas incrementais têm de bater com um recálculo completo
+    MetricasVolume recalculadas;
+    reconstruirMetricas(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, recalculadas);
+    if (metricasDoDisco(disk) && !mesmasMetricas(metricasVolume, recalculadas)) {
+        cout << "Métricas incrementais divergem do recálculo; substituídas pelo recálculo." << endl;
+        metricasVolume = recalculadas;
+    }
+    if (!verificarCodificacaoListas()) {
+        cout << "Erro: a codificação das listas de blocos não reproduz os blocos gravados!" << endl;
+    }
+    if (resultado.problemas.empty()) return;
+
+    char resposta;
+    cout << "Reparar? (s/n): ";
+    cin >> resposta;
+    if (resposta != 's' && resposta != 'S') return;
+
+    int alterados = repararFsck(resultado, disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                tabelaDiretorio);
+    cout << "Reparo concluído: " << alterados << " bloco(s) reescrito(s)." << endl;
+    reconstruirMetricas(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+    ResultadoFsck depois = executarFsck(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                        tabelaDiretorio);
+    displayResultadoFsck(depois, disk.size());
+}
+
+// ---------------- snapshots copy-on-write ----------------
+// um snapshot é uma raiz imutável que aponta para páginas imutáveis do mapa de blocos e do diretório,
+// com contagem de referências (shared_ptr). Clonar um snapshot copia só o ponteiro da raiz (O(1)); um
+// snapshot novo reaproveita toda página igual à do snapshot base e só aloca as páginas que mudaram.
+// o volume em uso continua sendo o vector<int> manipulado pelos alocadores: restaurar copia para ele
+// apenas as páginas que diferem
+constexpr int BLOCOS_POR_PAGINA = 16;
+constexpr int PAGINAS_DIRETORIO = 8; // o diretório é dividido por hash do nome
+
+struct PaginaBlocos {
+    vector<int> blocos;
+};
+
+struct PaginaDiretorio {
+    vector<File> arquivos;                            // ordenados por nome
+    vector<pair<string, tuple<int, int>>> tabela;     // entradas da tabela de diretório, ordenadas por nome
+};
+
+struct RaizSnapshot {
+    int numBlocos = 0;
+    int tipoAlocacao = 0;
+    int fileID = 0;
+    vector<shared_ptr<const PaginaBlocos>> paginasBlocos;
+    vector<shared_ptr<const PaginaDiretorio>> paginasDiretorio;
+};
+
+using Snapshot = shared_ptr<const RaizSnapshot>;
+
+map<string, Snapshot> snapshots;
+Snapshot baseDosSnapshots; // último snapshot criado ou restaurado: fonte das páginas reaproveitadas
+
+size_t paginaDoNome(const string& nome) {
+    return hash<string>{}(nome) % PAGINAS_DIRETORIO;
+}
+
+bool mesmaPaginaDiretorio(const PaginaDiretorio& a, const PaginaDiretorio& b) {
+    if (a.tabela != b.tabela || a.arquivos.size() != b.arquivos.size()) return false;
+    for (size_t i = 0; i < a.arquivos.size(); ++i) {
+        if (a.arquivos[i].name != b.arquivos[i].name || !mesmoArquivo(a.arquivos[i], b.arquivos[i])) return false;
+    }
+    return true;
+}
+
+vector<PaginaDiretorio> paginarDiretorio(const unordered_map<string, File>& filesContiguous,
+                                         const unordered_map<string, File>& filesEncadeados,
+                                         const unordered_map<string, File>& filesIndexados,
+                                         const unordered_map<string, File>& filesExtents,
+                                         const unordered_map<string, tuple<int, int>>& tabela) {
+    vector<PaginaDiretorio> paginas(PAGINAS_DIRETORIO);
+    for (const auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+        for (const auto& [nome, file] : *files) paginas[paginaDoNome(nome)].arquivos.push_back(file);
+    }
+    for (const auto& [nome, entrada] : tabela) paginas[paginaDoNome(nome)].tabela.push_back({nome, entrada});
+    for (PaginaDiretorio& pagina : paginas) {
+        sort(pagina.arquivos.begin(), pagina.arquivos.end(),
+             [](const File& a, const File& b) { return a.name < b.name; });
+        sort(pagina.tabela.begin(), pagina.tabela.end());
+    }
+    return paginas;
+}
+
+// cria um snapshot do volume; páginas iguais às do snapshot base são compartilhadas
+Snapshot criarSnapshot(const vector<int>& disk,
+                       const unordered_map<string, File>& filesContiguous,
+                       const unordered_map<string, File>& filesEncadeados,
+                       const unordered_map<string, File>& filesIndexados,
+                       const unordered_map<string, File>& filesExtents,
+                       int tipoAlocacao, int fileID,
+                       const Snapshot& base,
+                       int& paginasNovas) {
+    auto raiz = make_shared<RaizSnapshot>();
+    raiz->numBlocos = static_cast<int>(disk.size());
+    raiz->tipoAlocacao = tipoAlocacao;
+    raiz->fileID = fileID;
+    paginasNovas = 0;
+
+    bool baseCompativel = base && base->numBlocos == raiz->numBlocos;
+    int numPaginas = (raiz->numBlocos + BLOCOS_POR_PAGINA - 1) / BLOCOS_POR_PAGINA;
+    for (int p = 0; p < numPaginas; ++p) {
+        auto inicio = disk.begin() + p * BLOCOS_POR_PAGINA;
+        auto fim = disk.begin() + min(raiz->numBlocos, (p + 1) * BLOCOS_POR_PAGINA);
+        if (baseCompativel && equal(inicio, fim, base->paginasBlocos[p]->blocos.begin(), base->paginasBlocos[p]->blocos.end())) {
+            raiz->paginasBlocos.push_back(base->paginasBlocos[p]);
+            continue;
+        }
+        raiz->paginasBlocos.push_back(make_shared<const PaginaBlocos>(PaginaBlocos{vector<int>(inicio, fim)}));
+        paginasNovas++;
+    }
+
+    vector<PaginaDiretorio> paginas = paginarDiretorio(filesContiguous, filesEncadeados, filesIndexados,
+                                                       filesExtents, tabelaDiretorio);
+    for (int p = 0; p < PAGINAS_DIRETORIO; ++p) {
+        if (base && mesmaPaginaDiretorio(paginas[p], *base->paginasDiretorio[p])) {
+            raiz->paginasDiretorio.push_back(base->paginasDiretorio[p]);
+            continue;
+        }
+        raiz->paginasDiretorio.push_back(make_shared<const PaginaDiretorio>(move(paginas[p])));
+        paginasNovas++;
+    }
+    return raiz;
+}
+
+// volta o volume ao estado do snapshot, copiando só as páginas que diferem do volume atual
+int restaurarSnapshot(const Snapshot& snapshot,
+                      vector<int>& disk,
+                      unordered_map<string, File>& filesContiguous,
+                      unordered_map<string, File>& filesEncadeados,
+                      unordered_map<string, File>& filesIndexados,
+                      unordered_map<string, File>& filesExtents,
+                      int& tipoAlocacao, int& fileID) {
+    int paginasCopiadas = 0;
+    if ((int)disk.size() != snapshot->numBlocos) disk.assign(snapshot->numBlocos, BLOCO_LIVRE);
+    for (size_t p = 0; p < snapshot->paginasBlocos.size(); ++p) {
+        const vector<int>& blocos = snapshot->paginasBlocos[p]->blocos;
+        auto inicio = disk.begin() + p * BLOCOS_POR_PAGINA;
+        if (equal(blocos.begin(), blocos.end(), inicio)) continue;
+        for (size_t i = 0; i < blocos.size(); ++i) {
+            if (inicio[i] != blocos[i]) invalidarBlocoCache(cacheBlocos, static_cast<int>(p * BLOCOS_POR_PAGINA + i));
+        }
+        copy(blocos.begin(), blocos.end(), inicio);
+        paginasCopiadas++;
+    }
+
+    unordered_map<string, File>* mapas[] = {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents};
+    vector<PaginaDiretorio> atuais = paginarDiretorio(filesContiguous, filesEncadeados, filesIndexados,
+                                                      filesExtents, tabelaDiretorio);
+    for (int p = 0; p < PAGINAS_DIRETORIO; ++p) {
+        const PaginaDiretorio& alvo = *snapshot->paginasDiretorio[p];
+        if (mesmaPaginaDiretorio(atuais[p], alvo)) continue;
+        for (const File& file : atuais[p].arquivos) mapas[file.metodo - 1]->erase(file.name);
+        for (const auto& [nome, entrada] : atuais[p].tabela) tabelaDiretorio.erase(nome);
+        for (const File& file : alvo.arquivos) (*mapas[file.metodo - 1])[file.name] = file;
+        for (const auto& [nome, entrada] : alvo.tabela) tabelaDiretorio[nome] = entrada;
+        paginasCopiadas++;
+    }
+    tipoAlocacao = snapshot->tipoAlocacao;
+    fileID = snapshot->fileID;
+    return paginasCopiadas;
+}
+
+void displaySnapshots() {
+    if (snapshots.empty()) {
+        cout << "Nenhum snapshot salvo." << endl;
+        return;
+    }
+    // páginas distintas entre todos os snapshots vs. o que cópias completas ocupariam
+    unordered_map<const void*, int> distintas;
+    size_t referencias = 0;
+    cout << left << setw(16) << "Snapshot" << right << setw(8) << "Blocos" << setw(10) << "Arquivos"
+         << setw(11) << "Páginas" << setw(12) << "Exclusivas" << "\n";
+    for (const auto& [nome, snapshot] : snapshots) {
+        int arquivos = 0, exclusivas = 0, paginas = 0;
+        auto contar = [&](const void* pagina, long usos) {
+            paginas++;
+            referencias++;
+            distintas[pagina]++;
+            if (usos == 1) exclusivas++; // só esta raiz aponta para a página
+        };
+        for (const auto& pagina : snapshot->paginasBlocos) contar(pagina.get(), pagina.use_count());
+        for (const auto& pagina : snapshot->paginasDiretorio) {
+            contar(pagina.get(), pagina.use_count());
+            arquivos += pagina->arquivos.size();
+        }
+        cout << left << setw(16) << nome << right << setw(8) << snapshot->numBlocos << setw(10) << arquivos
+             << setw(10) << paginas << setw(12) << exclusivas << "\n";
+    }
+    cout << distintas.size() << " páginas distintas para " << referencias << " referências ("
+         << referencias - distintas.size() << " compartilhadas)" << endl;
+}
+
+void snapshotsMenu(vector<int>& disk,
+                   unordered_map<string, File>& filesContiguous,
+                   unordered_map<string, File>& filesEncadeados,
+                   unordered_map<string, File>& filesIndexados,
+                   unordered_map<string, File>& filesExtents,
+                   int& tipoAlocacao, int& fileID) {
+    displaySnapshots();
+
+    int opcao;
+    cout << "Snapshots:\n1. Criar snapshot do volume\n2. Clonar snapshot\n3. Restaurar snapshot\n4. Apagar snapshot\n";
+    cin >> opcao;
+    if (cin.fail() || opcao < 1 || opcao > 4) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Opção inválida!" << endl;
+        return;
+    }
+
+    string nome;
+    cout << "Nome do snapshot: ";
+    cin >> nome;
+    auto it = snapshots.find(nome);
+    if (opcao != 1 && it == snapshots.end()) {
+        cout << "Snapshot " << nome << " não encontrado." << endl;
+        return;
+    }
+
+    if (opcao == 1) {
+        // buffers pendentes ainda não têm blocos: sincroniza antes de congelar o volume
+        descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID, "snapshot");
+        int paginasNovas;
+        Snapshot snapshot = criarSnapshot(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                          tipoAlocacao, fileID, baseDosSnapshots, paginasNovas);
+        snapshots[nome] = snapshot;
+        baseDosSnapshots = snapshot;
+        cout << "Snapshot " << nome << " criado: " << paginasNovas << " página(s) nova(s), "
+             << snapshot->paginasBlocos.size() + snapshot->paginasDiretorio.size() - paginasNovas
+             << " compartilhada(s)." << endl;
+    } else if (opcao == 2) {
+        string destino;
+        cout << "Nome do clone: ";
+        cin >> destino;
+        snapshots[destino] = it->second; // só a raiz é compartilhada: O(1)
+        cout << "Snapshot " << destino << " clonado de " << nome << "." << endl;
+    } else if (opcao == 3) {
+        alocacaoAtrasada.buffers.clear();
+        for (auto itTabela = tabelaDiretorio.begin(); itTabela != tabelaDiretorio.end();) {
+            // arquivos novos que só existiam no buffer não fazem parte do snapshot
+            if (itTabela->second == make_tuple(-1, 0)) itTabela = tabelaDiretorio.erase(itTabela);
+            else ++itTabela;
+        }
+        int copiadas = restaurarSnapshot(it->second, disk, filesContiguous, filesEncadeados, filesIndexados,
+                                         filesExtents, tipoAlocacao, fileID);
+        baseDosSnapshots = it->second;
+        estadosReadahead.clear();
+        reconstruirMetricas(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+        if (journal.modo != JOURNAL_DESATIVADO) {
+            iniciarJournal(journal, journal.modo,
+                           capturarEstado(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents));
+        }
+        cout << "Snapshot " << nome << " restaurado: " << copiadas << " página(s) copiada(s)." << endl;
+    } else {
+        if (baseDosSnapshots == it->second) baseDosSnapshots.reset();
+        snapshots.erase(it);
+        cout << "Snapshot " << nome << " apagado." << endl;
+    }
+}
+
+// ---------------- executor de experimentos (todas as estratégias em paralelo) ----------------
+// a mesma carga é executada por instâncias independentes do simulador (disco, maps, tabela e cache
+// próprios), uma por combinação de estratégia x política de cache x capacidade x repetição
+constexpr int ESTRATEGIA_ADAPTATIVA = METODO_MISTO; // modo misto escolhendo o método de cada arquivo
+const int CAPACIDADES_EXPERIMENTO[] = {8, 16, 32};
+
+enum TipoOperacaoCarga { CARGA_CRIAR, CARGA_ESTENDER, CARGA_REMOVER, CARGA_LER };
+
+struct OperacaoCarga {
+    TipoOperacaoCarga tipo;
+    unsigned sorteio;   // escolhe o arquivo alvo entre os existentes no momento da operação
+    int bytes;
+    bool vaiCrescer;
+};
+
+struct ConfiguracaoExperimento {
+    int estrategia;
+    int politica;
+    int capacidade;
+    int repeticao;
+};
+
+struct ResultadoExperimento {
+    double fragExterna = 0;      // %
+    long long fragInterna = 0;   // bytes
+    int tentativas = 0;
+    int falhas = 0;
+    long long nsAlocacao = 0;
+    long long custoLeitura = 0;  // ms
+    int leituras = 0;
+    long long acertosCache = 0;
+    long long acessosCache = 0;
+};
+
+// 40% criações, 25% extensões, 15% remoções e 20% leituras
+vector<OperacaoCarga> gerarCarga(int numOperacoes, unsigned semente) {
+    mt19937 rng(semente);
+    vector<OperacaoCarga> carga;
+    for (int i = 0; i < numOperacoes; ++i) {
+        int sorteio = rng() % 100;
+        OperacaoCarga op;
+        op.tipo = sorteio < 40 ? CARGA_CRIAR : sorteio < 65 ? CARGA_ESTENDER : sorteio < 80 ? CARGA_REMOVER : CARGA_LER;
+        op.sorteio = rng();
+        op.bytes = op.tipo == CARGA_CRIAR ? 8 + rng() % 57 : 4 + rng() % 29;
+        op.vaiCrescer = rng() % 2;
+        carga.push_back(op);
+    }
+    return carga;
+}
+
+// monta disco, maps e tabela a partir de um snapshot, sem tocar no estado global
+void materializarSnapshot(const Snapshot& snapshot,
+                          vector<int>& disk,
+                          unordered_map<string, File>* mapas[4],
+                          unordered_map<string, tuple<int, int>>& tabela) {
+    disk.clear();
+    for (const auto& pagina : snapshot->paginasBlocos) disk.insert(disk.end(), pagina->blocos.begin(), pagina->blocos.end());
+    for (const auto& pagina : snapshot->paginasDiretorio) {
+        for (const File& file : pagina->arquivos) (*mapas[file.metodo - 1])[file.name] = file;
+        for (const auto& [nome, entrada] : pagina->tabela) {
+            if (entrada != make_tuple(-1, 0)) tabela[nome] = entrada;
+        }
+    }
+}
+
+ResultadoExperimento executarExperimento(const ConfiguracaoExperimento& config,
+                                         const vector<OperacaoCarga>& carga,
+                                         int numBlocos,
+                                         const Snapshot& inicial) {
+    vector<int> disk(numBlocos, BLOCO_LIVRE);
+    unordered_map<string, File> filesContiguous, filesEncadeados, filesIndexados, filesExtents;
+    unordered_map<string, File>* mapas[] = {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents};
+    unordered_map<string, tuple<int, int>> tabela;
+    int fileID = 0;
+    vector<string> vivos;
+    if (inicial) {
+        materializarSnapshot(inicial, disk, mapas, tabela);
+        for (auto* files : mapas) for (const auto& [nome, file] : *files) vivos.push_back(nome);
+        sort(vivos.begin(), vivos.end());
+    }
+
+    // a mesma repetição embaralha igual em todas as estratégias
+    geradorEmbaralhamento().seed(1000 + config.repeticao);
+    CacheBlocos cache;
+    configurarCache(cache, config.politica, config.capacidade);
+
+    ResultadoExperimento resultado;
+    for (size_t i = 0; i < carga.size(); ++i) {
+        const OperacaoCarga& op = carga[i];
+        if (op.tipo != CARGA_CRIAR && vivos.empty()) continue;
+        size_t alvo = vivos.empty() ? 0 : op.sorteio % vivos.size();
+
+        if (op.tipo == CARGA_CRIAR || op.tipo == CARGA_ESTENDER) {
+            auto inicio = chrono::steady_clock::now();
+            ResultadoAlocacao r;
+            if (op.tipo == CARGA_CRIAR) {
+                int blocos = (op.bytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+                int metodo = config.estrategia == ESTRATEGIA_ADAPTATIVA
+                           ? escolherMetodoAdaptativo(disk, blocos, op.vaiCrescer) : config.estrategia;
+                string nome = "w" + to_string(i);
+                r = alocarArquivoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela,
+                                       metodo, nome, op.bytes, blocos, fileID);
+                if (r == ALOCACAO_OK) vivos.push_back(nome);
+            } else {
+                r = alocarExtensaoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela,
+                                        vivos[alvo], op.bytes);
+            }
+            resultado.nsAlocacao += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+            resultado.tentativas++;
+            if (r != ALOCACAO_OK) resultado.falhas++;
+            continue;
+        }
+
+        auto* files = buscarMapaDoArquivo(vivos[alvo], filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+        const File& file = files->at(vivos[alvo]);
+        vector<int> blocos = blocosDoArquivo(file);
+        if (file.metodo == METODO_INDEXADO) blocos.insert(blocos.begin(), file.indexBlock);
+
+        if (op.tipo == CARGA_REMOVER) {
+            for (int bloco : blocos) invalidarBlocoCache(cache, bloco);
+            removerArquivo(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela, vivos[alvo]);
+            vivos.erase(vivos.begin() + alvo);
+            continue;
+        }
+
+        // leitura sequencial do arquivo inteiro
+        int posicao = -1;
+        for (int bloco : blocos) {
+            resultado.acessosCache++;
+            if (acessarCache(cache, bloco)) {
+                resultado.acertosCache++;
+                continue;
+            }
+            resultado.custoLeitura += custoDispositivo(bloco, posicao, modeloTempo.sequencial, modeloTempo.aleatorio);
+        }
+        resultado.leituras++;
+    }
+
+    ResumoEspacoLivre livre = resumirEspacoLivre(disk);
+    resultado.fragExterna = livre.blocosLivres ? 100.0 * (1.0 - (double)livre.maiorTrecho / livre.blocosLivres) : 0.0;
+    for (auto* files : mapas) {
+        for (const auto& [nome, file] : *files) resultado.fragInterna += computeFragmentation(file.size, file.sizeBytes);
+    }
+    return resultado;
+}
+
+// executa tarefa(i) para i em [0, total); cada thread do pool pega o próximo índice livre
+template <typename Tarefa>
+void executarNoPool(size_t total, int threads, Tarefa tarefa) {
+    atomic<size_t> proximo{0};
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            for (size_t i = proximo.fetch_add(1); i < total; i = proximo.fetch_add(1)) tarefa(i);
+        });
+    }
+    for (thread& trabalhador : pool) trabalhador.join();
+}
+
+void executarExperimentosMenu(const vector<int>& disk) {
+    int numOperacoes, repeticoes;
+    string nomeSnapshot;
+    cout << "Número de operações da carga: ";
+    cin >> numOperacoes;
+    cout << "Repetições por configuração: ";
+    cin >> repeticoes;
+    cout << "Partir de qual snapshot? (nome ou - para disco vazio): ";
+    cin >> nomeSnapshot;
+    if (cin.fail() || numOperacoes <= 0 || repeticoes <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Valores inválidos!" << endl;
+        return;
+    }
+    Snapshot inicial;
+    if (nomeSnapshot != "-") {
+        auto it = snapshots.find(nomeSnapshot);
+        if (it == snapshots.end()) {
+            cout << "Snapshot " << nomeSnapshot << " não encontrado." << endl;
+            return;
+        }
+        inicial = it->second;
+    }
+    int numBlocos = inicial ? inicial->numBlocos : static_cast<int>(disk.size());
+
+    vector<ConfiguracaoExperimento> configuracoes;
+    for (int estrategia = METODO_CONTIGUO; estrategia <= ESTRATEGIA_ADAPTATIVA; ++estrategia) {
+        for (int politica = CACHE_DESATIVADO; politica <= CACHE_ARC; ++politica) {
+            for (int capacidade : CAPACIDADES_EXPERIMENTO) {
+                if (politica == CACHE_DESATIVADO && capacidade != CAPACIDADES_EXPERIMENTO[0]) continue;
+                for (int r = 0; r < repeticoes; ++r) configuracoes.push_back({estrategia, politica, capacidade, r});
+            }
+        }
+    }
+    // uma carga por repetição, compartilhada (somente leitura) por todas as estratégias
+    vector<vector<OperacaoCarga>> cargas;
+    for (int r = 0; r < repeticoes; ++r) cargas.push_back(gerarCarga(numOperacoes, 42 + r));
+
+    int threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    vector<ResultadoExperimento> resultados(configuracoes.size());
+    auto inicio = chrono::steady_clock::now();
+    executarNoPool(configuracoes.size(), threads, [&](size_t i) {
+        resultados[i] = executarExperimento(configuracoes[i], cargas[configuracoes[i].repeticao], numBlocos, inicial);
+    });
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    cout << "\n" << configuracoes.size() << " execuções (" << numOperacoes << " operações, disco de " << numBlocos
+         << " blocos) em " << fixed << setprecision(2) << segundos << " s com " << threads << " thread(s)\n";
+    cout << preencherColuna("Estratégia", 12) << left << setw(10) << "Cache" << right << setw(6) << "Cap." << setw(12)
+         << "Frag.ext.%" << setw(14) << "Frag.int.(B)" << setw(10) << "Falhas%" << setw(13) << "Aloc.(µs)"
+         << setw(14) << "Leitura(ms)" << setw(11) << "Acertos%" << "\n";
+    // as repetições de cada configuração são consecutivas: média de cada bloco de repetições
+    for (size_t i = 0; i < configuracoes.size(); i += repeticoes) {
+        ResultadoExperimento soma;
+        double fragExterna = 0;
+        for (int r = 0; r < repeticoes; ++r) {
+            const ResultadoExperimento& res = resultados[i + r];
+            fragExterna += res.fragExterna;
+            soma.fragInterna += res.fragInterna;
+            soma.tentativas += res.tentativas;
+            soma.falhas += res.falhas;
+            soma.nsAlocacao += res.nsAlocacao;
+            soma.custoLeitura += res.custoLeitura;
+            soma.leituras += res.leituras;
+            soma.acertosCache += res.acertosCache;
+            soma.acessosCache += res.acessosCache;
+        }
+        const ConfiguracaoExperimento& config = configuracoes[i];
+        string estrategia = config.estrategia == ESTRATEGIA_ADAPTATIVA ? "Adaptativa" : nomeDoMetodo(config.estrategia);
+        cout << preencherColuna(estrategia, 12) << left << setw(10) << nomeDaPolitica(config.politica) << right << setw(6)
+             << (config.politica == CACHE_DESATIVADO ? 0 : config.capacidade)
+             << setprecision(1) << setw(12) << fragExterna / repeticoes
+             << setw(14) << (double)soma.fragInterna / repeticoes
+             << setw(10) << (soma.tentativas ? 100.0 * soma.falhas / soma.tentativas : 0.0)
+             << setprecision(2) << setw(12) << (soma.tentativas ? soma.nsAlocacao / 1000.0 / soma.tentativas : 0.0)
+             << setw(14) << (soma.leituras ? (double)soma.custoLeitura / soma.leituras : 0.0)
+             << setprecision(1) << setw(11)
+             << (soma.acessosCache ? 100.0 * soma.acertosCache / soma.acessosCache : 0.0) << "\n";
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// ---------------- núcleo concorrente ----------------
+// versão dos alocadores (contígua, encadeada e indexada) que aceita chamadas simultâneas de várias
+// threads. O disco é dividido em grupos de blocos, cada um com a própria trava para o espaço livre;
+// o diretório é dividido em fragmentos com trava de leitura/escrita; e cada arquivo tem uma trava de
+// leitura/escrita para os metadados. Ordem das travas: arquivo -> grupos (em ordem crescente); a trava
+// do fragmento do diretório nunca é mantida enquanto outra é pedida
+constexpr int BLOCOS_POR_GRUPO = 64;
+constexpr int FRAGMENTOS_DIRETORIO = 64;
+
+// magazines: cada thread guarda alguns blocos livres já reservados, todos de um mesmo grupo, e os
+// entrega sem travar nada. A recarga pega um lote do grupo preferido do pedido; com os grupos
+// esgotados, a thread rouba blocos dos magazines das outras. Os blocos reservados ficam marcados com
+// BLOCO_RESERVADO
+constexpr int BLOCO_RESERVADO = -3;
+constexpr int CAPACIDADE_MAGAZINE = 32;
+constexpr int LOTE_RECARGA = 16;
+constexpr int MAX_MAGAZINES = 64; // acima disso, threads dividem magazines (as operações continuam seguras)
+
+struct Magazine {
+    atomic<int> slots[CAPACIDADE_MAGAZINE]; // -1 = vazio
+    atomic<int> grupo{-1};                  // grupo de onde vieram os blocos guardados
+};
+
+// grupo de alocação: cada grupo tem um resumo do espaço livre, gravado sob a trava do grupo e lido
+// sem ela para escolher onde alocar; só o grupo escolhido é travado e percorrido
+struct GrupoAlocacao {
+    mutex trava;
+    int inicio = 0;
+    int fim = 0;
+    atomic<int> livres{0};
+    atomic<int> maiorTrecho{0}; // maior sequência de blocos livres dentro do grupo
+};
+
+struct ArquivoConcorrente {
+    shared_mutex trava;    // compartilhada nas leituras, exclusiva na extensão e na remoção
+    File file;
+    bool removido = false;
+};
+
+struct FragmentoDiretorio {
+    shared_mutex trava;
+    unordered_map<string, shared_ptr<ArquivoConcorrente>> arquivos;
+};
+
+struct VolumeConcorrente {
+    vector<atomic<int>> disk;
+    vector<unique_ptr<GrupoAlocacao>> grupos;
+    FragmentoDiretorio diretorio[FRAGMENTOS_DIRETORIO];
+    atomic<int> proximoID{0};
+    bool usarMagazines = false;
+    unsigned geracao = 0;             // identifica o volume para o índice de magazine de cada thread
+    unique_ptr<Magazine[]> magazines;
+    atomic<int> proximoMagazine{0};
+    atomic<long long> retiradasRapidas{0};
+    atomic<long long> recargas{0};
+    atomic<long long> roubos{0};
+    atomic<long long> reservas{0};       // pedidos de blocos aos grupos (criação e extensão)
+    atomic<long long> gruposTravados{0}; // grupos travados para atender esses pedidos
+};
+
+atomic<unsigned> geracaoDosVolumes{0};
+
+void iniciarVolumeConcorrente(VolumeConcorrente& volume, int numBlocos, bool usarMagazines = false) {
+    volume.usarMagazines = usarMagazines;
+    volume.geracao = geracaoDosVolumes.fetch_add(1) + 1;
+    volume.magazines.reset(new Magazine[MAX_MAGAZINES]);
+    for (int m = 0; m < MAX_MAGAZINES; ++m) {
+        for (atomic<int>& slot : volume.magazines[m].slots) slot.store(-1, memory_order_relaxed);
+    }
+    volume.disk = vector<atomic<int>>(numBlocos);
+    for (atomic<int>& bloco : volume.disk) bloco.store(BLOCO_LIVRE, memory_order_relaxed);
+    volume.grupos.clear();
+    for (int inicio = 0; inicio < numBlocos; inicio += BLOCOS_POR_GRUPO) {
+        auto grupo = make_unique<GrupoAlocacao>();
+        grupo->inicio = inicio;
+        grupo->fim = min(numBlocos, inicio + BLOCOS_POR_GRUPO);
+        grupo->livres = grupo->fim - grupo->inicio;
+        grupo->maiorTrecho = grupo->livres.load();
+        volume.grupos.push_back(move(grupo));
+    }
+}
+
+int grupoDoBloco(int bloco) {
+    return bloco / BLOCOS_POR_GRUPO;
+}
+
+// grupo onde um arquivo novo tenta ficar inteiro: o nome espalha os arquivos pelo disco (como os
+// grupos de cilindros do FFS), e as extensões preferem o grupo do último bloco do arquivo
+size_t grupoPreferido(VolumeConcorrente& volume, const string& nome) {
+    return hash<string>{}(nome) / FRAGMENTOS_DIRETORIO % volume.grupos.size();
+}
+
+size_t grupoParaExtensao(const File& file) {
+    int ultimo = file.dataBlocks.empty() ? file.startBlock : file.dataBlocks.back();
+    return ultimo >= 0 ? grupoDoBloco(ultimo) : 0;
+}
+
+// recalcula o maior trecho livre; chamada com a trava do grupo, percorre só os blocos dele
+void atualizarResumoGrupo(VolumeConcorrente& volume, GrupoAlocacao& grupo) {
+    int maior = 0, corrida = 0;
+    for (int b = grupo.inicio; b < grupo.fim; ++b) {
+        corrida = volume.disk[b].load(memory_order_relaxed) == BLOCO_LIVRE ? corrida + 1 : 0;
+        maior = max(maior, corrida);
+    }
+    grupo.maiorTrecho.store(maior, memory_order_relaxed);
+}
+
+FragmentoDiretorio& fragmentoDoNome(VolumeConcorrente& volume, const string& nome) {
+    return volume.diretorio[hash<string>{}(nome) % FRAGMENTOS_DIRETORIO];
+}
+
+shared_ptr<ArquivoConcorrente> buscarArquivoConcorrente(VolumeConcorrente& volume, const string& nome) {
+    FragmentoDiretorio& fragmento = fragmentoDoNome(volume, nome);
+    shared_lock<shared_mutex> leitura(fragmento.trava);
+    auto it = fragmento.arquivos.find(nome);
+    return it == fragmento.arquivos.end() ? nullptr : it->second;
+}
+
+// devolve blocos ao espaço livre, travando um grupo por vez
+void liberarBlocosConcorrente(VolumeConcorrente& volume, vector<int> blocos) {
+    sort(blocos.begin(), blocos.end());
+    size_t i = 0;
+    while (i < blocos.size()) {
+        GrupoAlocacao& grupo = *volume.grupos[grupoDoBloco(blocos[i])];
+        lock_guard<mutex> trava(grupo.trava);
+        for (; i < blocos.size() && blocos[i] < grupo.fim; ++i) {
+            volume.disk[blocos[i]].store(BLOCO_LIVRE, memory_order_relaxed);
+            grupo.livres++;
+        }
+        atualizarResumoGrupo(volume, grupo);
+    }
+}
+
+int indiceDoMagazine(VolumeConcorrente& volume) {
+    thread_local unsigned geracao = 0;
+    thread_local int indice = 0;
+    if (geracao != volume.geracao) {
+        geracao = volume.geracao;
+        indice = volume.proximoMagazine.fetch_add(1, memory_order_relaxed) % MAX_MAGAZINES;
+    }
+    return indice;
+}
+
+// arquivo novo da encadeada ou indexada: com magazines, o grupo do magazine da thread, que costuma ter
+// blocos suficientes sem travar nada (como os grupos de localidade por CPU do ext4 para arquivos
+// pequenos); sem magazines, ou com o magazine ainda vazio, o grupo do nome
+size_t grupoParaBlocosAvulsos(VolumeConcorrente& volume, const string& nome) {
+    if (volume.usarMagazines) {
+        int grupo = volume.magazines[indiceDoMagazine(volume)].grupo.load(memory_order_relaxed);
+        if (grupo >= 0) return static_cast<size_t>(grupo);
+    }
+    return grupoPreferido(volume, nome);
+}
+
+// caminho rápido: um exchange por slot, sem trava
+int retirarDoMagazine(Magazine& magazine) {
+    for (atomic<int>& slot : magazine.slots) {
+        if (slot.load(memory_order_relaxed) == -1) continue;
+        int bloco = slot.exchange(-1, memory_order_acquire);
+        if (bloco != -1) return bloco;
+    }
+    return -1;
+}
+
+// devolve aos grupos os blocos que sobraram no magazine (ao trocar o grupo dele)
+void esvaziarMagazine(VolumeConcorrente& volume, Magazine& magazine) {
+    vector<int> blocos;
+    for (int bloco; (bloco = retirarDoMagazine(magazine)) != -1;) blocos.push_back(bloco);
+    if (!blocos.empty()) liberarBlocosConcorrente(volume, move(blocos));
+}
+
+// recarga a partir de um único grupo, travado uma vez: se ele comporta o pedido inteiro, entrega os
+// `quantidade` blocos do pedido e guarda mais um lote do mesmo grupo nos slots vazios do magazine
+bool recarregarMagazine(VolumeConcorrente& volume, Magazine& magazine, size_t indiceGrupo, int quantidade,
+                        vector<int>& blocos) {
+    GrupoAlocacao& grupo = *volume.grupos[indiceGrupo];
+    if (grupo.livres.load(memory_order_relaxed) < quantidade) return false;
+    vector<int> lote;
+    {
+        lock_guard<mutex> trava(grupo.trava);
+        if (grupo.livres < quantidade) return false; // o resumo mudou entre a leitura e a trava
+        // uma passada pelo grupo: primeiro os blocos do pedido, depois o lote do magazine
+        int tomados = 0;
+        for (int b = grupo.inicio; b < grupo.fim && grupo.livres > 0 && (int)lote.size() < LOTE_RECARGA; ++b) {
+            if (volume.disk[b].load(memory_order_relaxed) != BLOCO_LIVRE) continue;
+            grupo.livres--;
+            if (tomados < quantidade) {
+                volume.disk[b].store(FIM_CADEIA, memory_order_relaxed);
+                blocos.push_back(b);
+                tomados++;
+            } else {
+                volume.disk[b].store(BLOCO_RESERVADO, memory_order_relaxed);
+                lote.push_back(b);
+            }
+        }
+        atualizarResumoGrupo(volume, grupo);
+        volume.gruposTravados.fetch_add(1, memory_order_relaxed);
+    }
+    magazine.grupo.store(static_cast<int>(indiceGrupo), memory_order_relaxed);
+    vector<int> sobras;
+    for (int bloco : lote) {
+        bool guardado = false;
+        for (atomic<int>& slot : magazine.slots) {
+            int vazio = -1;
+            if (slot.compare_exchange_strong(vazio, bloco, memory_order_release, memory_order_relaxed)) {
+                guardado = true;
+                break;
+            }
+        }
+        if (!guardado) sobras.push_back(bloco);
+    }
+    if (!sobras.empty()) liberarBlocosConcorrente(volume, sobras);
+    volume.recargas.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+// caminho dos magazines: o magazine da thread guarda blocos de um único grupo. Se é o grupo preferido,
+// o pedido sai dele sem travas, completado por uma recarga do mesmo grupo se faltar. Senão o que sobrou
+// volta ao grupo de origem e o magazine é recarregado do primeiro grupo, a partir do preferido, que
+// comporte o pedido inteiro. Assim os blocos de um arquivo ficam num só grupo como no caminho sem
+// magazines; false se nenhum grupo comporta o pedido
+bool reservarDoMagazine(VolumeConcorrente& volume, int quantidade, vector<int>& blocos, size_t preferido) {
+    Magazine& magazine = volume.magazines[indiceDoMagazine(volume)];
+    size_t antes = blocos.size();
+    if (magazine.grupo.load(memory_order_relaxed) == static_cast<int>(preferido)) {
+        for (int bloco; (int)(blocos.size() - antes) < quantidade && (bloco = retirarDoMagazine(magazine)) != -1;) {
+            volume.disk[bloco].store(FIM_CADEIA, memory_order_relaxed);
+            blocos.push_back(bloco);
+        }
+        int retirados = static_cast<int>(blocos.size() - antes);
+        volume.retiradasRapidas.fetch_add(retirados, memory_order_relaxed);
+        if (retirados == quantidade) return true;
+        if (recarregarMagazine(volume, magazine, preferido, quantidade - retirados, blocos)) return true;
+        liberarBlocosConcorrente(volume, vector<int>(blocos.begin() + antes, blocos.end()));
+        blocos.resize(antes);
+    }
+    esvaziarMagazine(volume, magazine);
+    size_t numGrupos = volume.grupos.size();
+    for (size_t k = 0; k < numGrupos && quantidade <= BLOCOS_POR_GRUPO; ++k) {
+        if (recarregarMagazine(volume, magazine, (preferido + k) % numGrupos, quantidade, blocos)) return true;
+    }
+    return false;
+}
+
+// disco esgotado nos grupos: completa o pedido com blocos parados nos magazines de todas as threads
+int roubarDosMagazines(VolumeConcorrente& volume, int quantidade, vector<int>& blocos) {
+    int roubados = 0;
+    for (int m = 0; m < MAX_MAGAZINES && roubados < quantidade; ++m) {
+        for (int bloco; roubados < quantidade && (bloco = retirarDoMagazine(volume.magazines[m])) != -1; ++roubados) {
+            volume.disk[bloco].store(FIM_CADEIA, memory_order_relaxed);
+            blocos.push_back(bloco);
+        }
+    }
+    volume.roubos.fetch_add(roubados, memory_order_relaxed);
+    return roubados;
+}
+
+// devolve aos grupos tudo o que está nos magazines (antes de exportar ou verificar o volume)
+void esvaziarMagazines(VolumeConcorrente& volume) {
+    vector<int> blocos;
+    for (int m = 0; m < MAX_MAGAZINES; ++m) {
+        for (atomic<int>& slot : volume.magazines[m].slots) {
+            int bloco = slot.exchange(-1, memory_order_acquire);
+            if (bloco != -1) blocos.push_back(bloco);
+        }
+    }
+    liberarBlocosConcorrente(volume, move(blocos));
+}
+
+// pega até `quantidade` blocos livres de um grupo já travado, marcando-os com FIM_CADEIA
+int tomarBlocosDoGrupo(VolumeConcorrente& volume, GrupoAlocacao& grupo, int quantidade, vector<int>& blocos) {
+    int tomados = 0;
+    for (int b = grupo.inicio; b < grupo.fim && tomados < quantidade && grupo.livres > 0; ++b) {
+        if (volume.disk[b].load(memory_order_relaxed) != BLOCO_LIVRE) continue;
+        volume.disk[b].store(FIM_CADEIA, memory_order_relaxed);
+        grupo.livres--;
+        tomados++;
+        blocos.push_back(b);
+    }
+    atualizarResumoGrupo(volume, grupo);
+    volume.gruposTravados.fetch_add(1, memory_order_relaxed);
+    return tomados;
+}
+
+// reserva blocos avulsos (encadeada/indexada); o bloco reservado fica marcado com FIM_CADEIA até o
+// chamador gravar o valor definitivo. Primeiro procura, pelos resumos e a partir do grupo preferido,
+// um grupo que comporte o pedido inteiro; só se nenhum couber os blocos são espalhados por vários.
+// Com magazines, o da thread é tentado antes para o mesmo grupo preferido, e os magazines das outras
+// threads entram só depois de esgotados os grupos. Se não houver blocos suficientes, desfaz tudo
+bool reservarBlocosConcorrente(VolumeConcorrente& volume, int quantidade, vector<int>& blocos, size_t preferido) {
+    if (volume.usarMagazines && reservarDoMagazine(volume, quantidade, blocos, preferido)) return true;
+
+    volume.reservas.fetch_add(1, memory_order_relaxed);
+    size_t numGrupos = volume.grupos.size();
+    size_t antes = blocos.size();
+    for (size_t k = 0; k < numGrupos && quantidade <= BLOCOS_POR_GRUPO; ++k) {
+        GrupoAlocacao& grupo = *volume.grupos[(preferido + k) % numGrupos];
+        if (grupo.livres.load(memory_order_relaxed) < quantidade) continue;
+        lock_guard<mutex> trava(grupo.trava);
+        if (grupo.livres < quantidade) continue; // o resumo mudou entre a leitura e a trava
+        tomarBlocosDoGrupo(volume, grupo, quantidade, blocos);
+        return true;
+    }
+    int faltam = quantidade;
+    for (size_t k = 0; k < numGrupos && faltam > 0; ++k) {
+        GrupoAlocacao& grupo = *volume.grupos[(preferido + k) % numGrupos];
+        if (grupo.livres.load(memory_order_relaxed) == 0) continue;
+        lock_guard<mutex> trava(grupo.trava);
+        faltam -= tomarBlocosDoGrupo(volume, grupo, faltam, blocos);
+    }
+    if (faltam > 0 && volume.usarMagazines) faltam -= roubarDosMagazines(volume, faltam, blocos);
+    if (faltam == 0) return true;
+    liberarBlocosConcorrente(volume, vector<int>(blocos.begin() + antes, blocos.end()));
+    blocos.resize(antes);
+    return false;
+}
+
+// reserva um trecho contíguo dentro de um único grupo; devolve o bloco inicial ou -1.
+// Grupos cujo maior trecho livre não comporta o pedido são pulados sem travar
+int reservarTrechoConcorrente(VolumeConcorrente& volume, int tamanho, size_t preferido) {
+    volume.reservas.fetch_add(1, memory_order_relaxed);
+    size_t numGrupos = volume.grupos.size();
+    for (size_t k = 0; k < numGrupos; ++k) {
+        GrupoAlocacao& grupo = *volume.grupos[(preferido + k) % numGrupos];
+        if (grupo.maiorTrecho.load(memory_order_relaxed) < tamanho) continue;
+        lock_guard<mutex> trava(grupo.trava);
+        volume.gruposTravados.fetch_add(1, memory_order_relaxed);
+        if (grupo.maiorTrecho < tamanho) continue;
+        int corrida = 0;
+        for (int b = grupo.inicio; b < grupo.fim; ++b) {
+            corrida = volume.disk[b].load(memory_order_relaxed) == BLOCO_LIVRE ? corrida + 1 : 0;
+            if (corrida < tamanho) continue;
+            int inicio = b - tamanho + 1;
+            for (int i = inicio; i <= b; ++i) volume.disk[i].store(inicio, memory_order_relaxed);
+            grupo.livres -= tamanho;
+            atualizarResumoGrupo(volume, grupo);
+            return inicio;
+        }
+    }
+    return -1;
+}
+
+// encadeia os blocos novos e liga o antigo fim da cadeia (anterior, ou -1 num arquivo novo) ao primeiro
+void encadearBlocosConcorrente(VolumeConcorrente& volume, int anterior, const vector<int>& novos) {
+    for (int bloco : novos) {
+        if (anterior >= 0) volume.disk[anterior].store(bloco, memory_order_relaxed);
+        anterior = bloco;
+    }
+    if (anterior >= 0) volume.disk[anterior].store(FIM_CADEIA, memory_order_relaxed);
+}
+
+ResultadoAlocacao criarArquivoConcorrente(VolumeConcorrente& volume, const string& nome, int tamanhoBytes, int metodo) {
+    int tamanhoBlocos = (tamanhoBytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    if (tamanhoBlocos <= 0) return ERRO_ESPACO_INSUFICIENTE;
+    if (metodo == METODO_INDEXADO && tamanhoBlocos > MAX_ENTRADAS_INDICE) return ERRO_INDICE_CHEIO;
+    if (buscarArquivoConcorrente(volume, nome)) return ERRO_ARQUIVO_EXISTENTE;
+
+    // o arquivo só fica visível no diretório depois de todos os blocos gravados
+    auto arquivo = make_shared<ArquivoConcorrente>();
+    File& file = arquivo->file;
+    file.name = nome;
+    file.sizeBytes = tamanhoBytes;
+    file.size = tamanhoBlocos;
+    file.metodo = metodo;
+    file.color = getFileColor(volume.proximoID.fetch_add(1, memory_order_relaxed));
+    file.fragmentacao = computeFragmentation(tamanhoBlocos, tamanhoBytes);
+
+    vector<int> reservados;
+    if (metodo == METODO_CONTIGUO) {
+        file.startBlock = reservarTrechoConcorrente(volume, tamanhoBlocos, grupoPreferido(volume, nome));
+        if (file.startBlock < 0) return ERRO_ESPACO_INSUFICIENTE;
+        reservados = blocosDoArquivo(file);
+    } else {
+        int extra = metodo == METODO_INDEXADO ? 1 : 0;
+        if (!reservarBlocosConcorrente(volume, tamanhoBlocos + extra, reservados, grupoParaBlocosAvulsos(volume, nome)))
+            return ERRO_ESPACO_INSUFICIENTE;
+        file.dataBlocks.assign(reservados.begin(), reservados.begin() + tamanhoBlocos);
+        file.startBlock = file.dataBlocks.front();
+        if (metodo == METODO_INDEXADO) {
+            file.indexBlock = reservados.back(); // já marcado com FIM_CADEIA
+            for (int bloco : file.dataBlocks) volume.disk[bloco].store(file.indexBlock, memory_order_relaxed);
+        } else {
+            encadearBlocosConcorrente(volume, -1, reservados);
+        }
+    }
+
+    FragmentoDiretorio& fragmento = fragmentoDoNome(volume, nome);
+    {
+        unique_lock<shared_mutex> escrita(fragmento.trava);
+        if (fragmento.arquivos.emplace(nome, arquivo).second) return ALOCACAO_OK;
+    }
+    // outra thread criou o mesmo nome enquanto os blocos eram reservados
+    liberarBlocosConcorrente(volume, reservados);
+    return ERRO_ARQUIVO_EXISTENTE;
+}
+
+ResultadoAlocacao estenderArquivoConcorrente(VolumeConcorrente& volume, const string& nome, int adicionalBytes) {
+    shared_ptr<ArquivoConcorrente> arquivo = buscarArquivoConcorrente(volume, nome);
+    if (!arquivo) return ERRO_ARQUIVO_INEXISTENTE;
+    unique_lock<shared_mutex> escrita(arquivo->trava);
+    if (arquivo->removido) return ERRO_ARQUIVO_INEXISTENTE;
+    File& file = arquivo->file;
+
+    int blocosAdicionais = blocosParaExtensao(file.sizeBytes, adicionalBytes);
+    if (file.metodo == METODO_CONTIGUO && blocosAdicionais > 0) {
+        // só no lugar, como na versão sequencial: trava os grupos do trecho seguinte em ordem crescente
+        int fim = file.startBlock + file.size;
+        if (fim + blocosAdicionais > (int)volume.disk.size()) return ERRO_SEM_ESPACO_CONTIGUO;
+        vector<unique_lock<mutex>> travas;
+        for (int g = grupoDoBloco(fim); g <= grupoDoBloco(fim + blocosAdicionais - 1); ++g) {
+            travas.emplace_back(volume.grupos[g]->trava);
+        }
+        for (int b = fim; b < fim + blocosAdicionais; ++b) {
+            if (volume.disk[b].load(memory_order_relaxed) != BLOCO_LIVRE) return ERRO_SEM_ESPACO_CONTIGUO;
+        }
+        for (int b = fim; b < fim + blocosAdicionais; ++b) {
+            volume.disk[b].store(file.startBlock, memory_order_relaxed);
+            volume.grupos[grupoDoBloco(b)]->livres--;
+        }
+        for (int g = grupoDoBloco(fim); g <= grupoDoBloco(fim + blocosAdicionais - 1); ++g) {
+            atualizarResumoGrupo(volume, *volume.grupos[g]);
+        }
+    } else if (blocosAdicionais > 0) {
+        if (file.metodo == METODO_INDEXADO && file.size + blocosAdicionais > MAX_ENTRADAS_INDICE)
+            return ERRO_INDICE_CHEIO;
+        vector<int> novos;
+        if (!reservarBlocosConcorrente(volume, blocosAdicionais, novos, grupoParaExtensao(file)))
+            return ERRO_ESPACO_INSUFICIENTE;
+        int anterior = file.dataBlocks.empty() ? -1 : file.dataBlocks.back();
+        file.dataBlocks.append(novos.begin(), novos.end());
+        if (file.metodo == METODO_INDEXADO) {
+            for (int bloco : novos) volume.disk[bloco].store(file.indexBlock, memory_order_relaxed);
+        } else {
+            encadearBlocosConcorrente(volume, anterior, novos);
+        }
+    }
+    file.size += blocosAdicionais;
+    file.sizeBytes += adicionalBytes;
+    file.fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+    return ALOCACAO_OK;
+}
+
+bool removerArquivoConcorrente(VolumeConcorrente& volume, const string& nome) {
+    shared_ptr<ArquivoConcorrente> arquivo;
+    FragmentoDiretorio& fragmento = fragmentoDoNome(volume, nome);
+    {
+        unique_lock<shared_mutex> escrita(fragmento.trava);
+        auto it = fragmento.arquivos.find(nome);
+        if (it == fragmento.arquivos.end()) return false;
+        arquivo = move(it->second);
+        fragmento.arquivos.erase(it);
+    }
+    // espera leituras e extensões em andamento terminarem antes de liberar os blocos
+    unique_lock<shared_mutex> escrita(arquivo->trava);
+    arquivo->removido = true;
+    vector<int> blocos = blocosDoArquivo(arquivo->file);
+    if (arquivo->file.metodo == METODO_INDEXADO) blocos.push_back(arquivo->file.indexBlock);
+    liberarBlocosConcorrente(volume, move(blocos));
+    return true;
+}
+
+// leitura sequencial do arquivo; a encadeada segue os ponteiros gravados no disco.
+// Devolve o custo em ms ou -1 se o arquivo não existe
+int lerArquivoConcorrente(VolumeConcorrente& volume, const string& nome) {
+    shared_ptr<ArquivoConcorrente> arquivo = buscarArquivoConcorrente(volume, nome);
+    if (!arquivo) return -1;
+    shared_lock<shared_mutex> leitura(arquivo->trava);
+    if (arquivo->removido) return -1;
+    const File& file = arquivo->file;
+    int posicao = -1, custo = 0;
+    if (file.metodo == METODO_ENCADEADO) {
+        for (int bloco = file.startBlock, passos = 0; bloco >= 0 && passos < file.size; ++passos) {
+            custo += custoDispositivo(bloco, posicao, modeloTempo.sequencial, modeloTempo.aleatorio);
+            bloco = volume.disk[bloco].load(memory_order_relaxed);
+        }
+        return custo;
+    }
+    if (file.metodo == METODO_INDEXADO) {
+        custo += custoDispositivo(file.indexBlock, posicao, modeloTempo.sequencial, modeloTempo.indice);
+    }
+    for (int bloco : blocosDoArquivo(file)) {
+        custo += custoDispositivo(bloco, posicao, modeloTempo.sequencial, modeloTempo.aleatorio);
+    }
+    return custo;
+}
+
+// copia o volume para as estruturas do simulador sequencial (para o fsck conferir)
+void exportarVolumeConcorrente(VolumeConcorrente& volume,
+                               vector<int>& disk,
+                               unordered_map<string, File>* mapas[4],
+                               unordered_map<string, tuple<int, int>>& tabela) {
+    disk.resize(volume.disk.size());
+    for (size_t b = 0; b < disk.size(); ++b) disk[b] = volume.disk[b].load(memory_order_relaxed);
+    for (FragmentoDiretorio& fragmento : volume.diretorio) {
+        shared_lock<shared_mutex> leitura(fragmento.trava);
+        for (const auto& [nome, arquivo] : fragmento.arquivos) {
+            shared_lock<shared_mutex> leituraArquivo(arquivo->trava);
+            (*mapas[arquivo->file.metodo - 1])[nome] = arquivo->file;
+            tabela[nome] = entradaEsperadaTabela(arquivo->file);
+        }
+    }
+}
+
+struct ResultadoBenchmark {
+    long long operacoes = 0;
+    double segundos = 0;
+    int inconsistencias = 0;
+    long long retiradasRapidas = 0;
+    long long recargas = 0;
+    long long roubos = 0;
+    long long reservas = 0;
+    long long gruposTravados = 0;
+    int arquivos = 0;
+    int arquivosEmUmGrupo = 0; // arquivos do volume final com todos os blocos (e o índice) num só grupo
+};
+
+// cada thread cria, estende, remove e lê arquivos próprios, e lê arquivos das outras threads;
+// cada thread mantém no máximo ARQUIVOS_POR_THREAD arquivos para o disco não encher durante a medição
+constexpr size_t ARQUIVOS_POR_THREAD = 64;
+
+ResultadoBenchmark executarBenchmarkConcorrente(int threads, int operacoesPorThread, int numBlocos,
+                                                bool usarMagazines) {
+    VolumeConcorrente volume;
+    iniciarVolumeConcorrente(volume, numBlocos, usarMagazines);
+    atomic<long long> operacoes{0};
+
+    auto inicio = chrono::steady_clock::now();
+    vector<thread> trabalhadores;
+    for (int t = 0; t < threads; ++t) {
+        trabalhadores.emplace_back([&, t]() {
+            mt19937 rng(7919 * (t + 1));
+            vector<string> meus;
+            long long feitas = 0;
+            for (int i = 0; i < operacoesPorThread; ++i) {
+                int sorteio = rng() % 100;
+                if (meus.size() >= ARQUIVOS_POR_THREAD) sorteio = 55; // força uma remoção
+                if (meus.empty() || sorteio < 35) {
+                    string nome = "t" + to_string(t) + "_" + to_string(i);
+                    int metodo = METODO_CONTIGUO + rng() % 3;
+                    if (criarArquivoConcorrente(volume, nome, 8 + rng() % 57, metodo) == ALOCACAO_OK) meus.push_back(nome);
+                } else if (sorteio < 55) {
+                    estenderArquivoConcorrente(volume, meus[rng() % meus.size()], 4 + rng() % 29);
+                } else if (sorteio < 70) {
+                    size_t alvo = rng() % meus.size();
+                    removerArquivoConcorrente(volume, meus[alvo]);
+                    meus.erase(meus.begin() + alvo);
+                } else if (sorteio < 85) {
+                    lerArquivoConcorrente(volume, meus[rng() % meus.size()]);
+                } else {
+                    int outra = rng() % threads;
+                    lerArquivoConcorrente(volume, "t" + to_string(outra) + "_" + to_string(rng() % operacoesPorThread));
+                }
+                feitas++;
+            }
+            operacoes.fetch_add(feitas, memory_order_relaxed);
+        });
+    }
+    for (thread& trabalhador : trabalhadores) trabalhador.join();
+
+    ResultadoBenchmark resultado;
+    resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    resultado.operacoes = operacoes.load();
+    resultado.retiradasRapidas = volume.retiradasRapidas.load();
+    resultado.recargas = volume.recargas.load();
+    resultado.roubos = volume.roubos.load();
+    esvaziarMagazines(volume);
+
+    vector<int> disk;
+    unordered_map<string, File> filesContiguous, filesEncadeados, filesIndexados, filesExtents;
+    unordered_map<string, File>* mapas[] = {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents};
+    unordered_map<string, tuple<int, int>> tabela;
+    exportarVolumeConcorrente(volume, disk, mapas, tabela);
+    resultado.inconsistencias = static_cast<int>(
+        executarFsck(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tabela).problemas.size());
+    resultado.reservas = volume.reservas.load();
+    resultado.gruposTravados = volume.gruposTravados.load();
+    for (unordered_map<string, File>* mapa : mapas) {
+        for (const auto& [nome, file] : *mapa) {
+            vector<int> blocos = blocosDoArquivo(file);
+            if (file.metodo == METODO_INDEXADO) blocos.push_back(file.indexBlock);
+            int grupo = grupoDoBloco(blocos.front());
+            resultado.arquivos++;
+            if (all_of(blocos.begin(), blocos.end(), [&](int b) { return grupoDoBloco(b) == grupo; }))
+                resultado.arquivosEmUmGrupo++;
+        }
+    }
+    return resultado;
+}
+
+void benchmarkConcorrenteMenu() {
+    int maxThreads, operacoesPorThread;
+    cout << "Número máximo de threads (núcleos disponíveis: " << thread::hardware_concurrency() << "): ";
+    cin >> maxThreads;
+    cout << "Operações por thread: ";
+    cin >> operacoesPorThread;
+    if (cin.fail() || maxThreads <= 0 || operacoesPorThread <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Valores inválidos!" << endl;
+        return;
+    }
+
+    constexpr int BLOCOS_BENCHMARK = 1 << 16;
+    vector<int> contagens;
+    for (int t = 1; t < maxThreads; t *= 2) contagens.push_back(t);
+    contagens.push_back(maxThreads);
+
+    cout << "\nNúcleo concorrente: disco de " << BLOCOS_BENCHMARK << " blocos em grupos de " << BLOCOS_POR_GRUPO
+         << ", " << FRAGMENTOS_DIRETORIO << " fragmentos de diretório\n";
+    for (bool usarMagazines : {false, true}) {
+        cout << (usarMagazines ? "\nCom magazines por thread (" : "\nSem magazines (")
+             << "blocos avulsos da encadeada e da indexada)\n";
+        cout << setw(8) << "Threads" << setw(14) << "Operações" << setw(14) << "ops/s" << setw(12) << "Speedup"
+             << setw(15) << "Eficiência" << setw(12) << "Inconsist." << setw(12) << "1 grupo";
+        if (usarMagazines) cout << setw(12) << "Rápidas" << setw(10) << "Recargas" << setw(10) << "Roubos";
+        else cout << setw(14) << "Grupos/res.";
+        cout << "\n";
+        double base = 0;
+        for (int threads : contagens) {
+            ResultadoBenchmark r = executarBenchmarkConcorrente(threads, operacoesPorThread, BLOCOS_BENCHMARK,
+                                                                usarMagazines);
+            double vazao = r.segundos > 0 ? r.operacoes / r.segundos : 0;
+            if (base == 0) base = vazao;
+            double speedup = base > 0 ? vazao / base : 0;
+            cout << fixed << setprecision(0) << setw(8) << threads << setw(12) << r.operacoes << setw(14) << vazao
+                 << setprecision(2) << setw(12) << speedup << setprecision(1) << setw(13) << 100 * speedup / threads
+                 << "%" << setw(12) << r.inconsistencias << setw(11)
+                 << (r.arquivos ? 100.0 * r.arquivosEmUmGrupo / r.arquivos : 0.0) << "%";
+            if (!usarMagazines) {
+                cout << setprecision(2) << setw(14) << (r.reservas ? (double)r.gruposTravados / r.reservas : 0.0);
+            } else {
+                long long retiradas = r.retiradasRapidas + r.recargas + r.roubos;
+                cout << setw(10) << (retiradas ? 100.0 * r.retiradasRapidas / retiradas : 0.0) << "%"
+                     << setw(10) << r.recargas << setw(10) << r.roubos;
+            }
+            cout << "\n";
+        }
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// ---------------- simulação de eventos discretos (relógio virtual) ----------------
+// o relógio virtual só avança de evento em evento: a fila guarda (instante, ordem, alvo) e o
+// dispositivo atende os pedidos na ordem de chegada, carimbando chegada, início e fim de cada um.
+// Horas de operação simulada custam só o processamento dos eventos, não o tempo que representam
+struct PedidoDispositivo {
+    long long chegada = 0;
+    long long inicio = 0; // começo do atendimento, depois da espera na fila
+    long long fim = 0;
+};
+
+struct DispositivoSimulado {
+    long long livreEm = 0; // instante em que termina o último pedido aceito
+    int posicao = -1;      // último bloco atendido
+    long long ocupado = 0;
+    long long somaEspera = 0;
+    long long pedidos = 0;
+};
+
+using EventoSimulado = tuple<long long, long long, int>; // instante, ordem de agendamento, alvo
+
+struct SimuladorEventos {
+    long long relogio = 0;      // ms
+    long long proximaOrdem = 0; // eventos no mesmo instante saem na ordem em que foram agendados
+    priority_queue<EventoSimulado, vector<EventoSimulado>, greater<EventoSimulado>> fila;
+};
+
+void agendarEvento(SimuladorEventos& simulador, long long instante, int alvo) {
+    simulador.fila.emplace(max(instante, simulador.relogio), simulador.proximaOrdem++, alvo);
+}
+
+// retira o próximo evento e avança o relógio até ele; false quando a fila acabou
+bool proximoEvento(SimuladorEventos& simulador, int& alvo) {
+    if (simulador.fila.empty()) return false;
+    simulador.relogio = get<0>(simulador.fila.top());
+    alvo = get<2>(simulador.fila.top());
+    simulador.fila.pop();
+    return true;
+}
+
+// entra na fila do dispositivo: transfere os blocos e depois grava os metadados (em outra região do
+// disco, então o próximo pedido começa com posicionamento)
+PedidoDispositivo submeterAoDispositivo(DispositivoSimulado& dispositivo, long long agora,
+                                        const vector<int>& blocos, int escritasMetadados) {
+    PedidoDispositivo pedido;
+    pedido.chegada = agora;
+    pedido.inicio = max(agora, dispositivo.livreEm);
+    long long custo = (long long)escritasMetadados * modeloTempo.metadado;
+    for (int bloco : blocos) {
+        custo += custoDispositivo(bloco, dispositivo.posicao, modeloTempo.sequencial, modeloTempo.aleatorio);
+    }
+    if (escritasMetadados > 0) dispositivo.posicao = -1;
+    pedido.fim = pedido.inicio + custo;
+    dispositivo.livreEm = pedido.fim;
+    dispositivo.ocupado += custo;
+    dispositivo.somaEspera += pedido.inicio - agora;
+    dispositivo.pedidos++;
+    return pedido;
+}
+
+// ---------------- clientes simulados ----------------
+// milhares de clientes disputam o mesmo disco. Cada cliente é uma máquina de estados retomável (o
+// equivalente em C++17 a uma corrotina sem pilha): roda até o próximo ponto de suspensão (pensar ou
+// esperar o dispositivo) e devolve o instante em que quer ser retomado. O simulador de eventos retoma
+// os clientes na ordem do relógio virtual; como o dispositivo atende um pedido por vez, a espera na
+// fila aparece na latência de cada operação
+constexpr int TEMPO_PENSAR_MEDIO = 50;  // ms entre o fim de uma operação e o pedido da próxima
+constexpr int ARQUIVOS_POR_CLIENTE = 4;
+constexpr int BLOCOS_POR_CLIENTE = 32;  // o disco do experimento cresce com o número de clientes
+const char* const NOMES_OPERACOES_CARGA[] = {"Criar", "Estender", "Remover", "Ler"};
+
+enum EtapaCliente { CLIENTE_PENSANDO, CLIENTE_AGUARDANDO_DISPOSITIVO, CLIENTE_TERMINADO };
+
+struct ClienteSimulado {
+    int id = 0;
+    EtapaCliente etapa = CLIENTE_PENSANDO;
+    mt19937 rng;
+    vector<string> arquivos;
+    TipoOperacaoCarga operacao = CARGA_CRIAR;
+    long long inicioOperacao = 0; // instante em que a operação em andamento foi pedida
+};
+
+struct EstatisticasOperacao {
+    vector<long long> latencias;
+    long long escritasMetadados = 0;
+    int falhas = 0;
+};
+
+struct MotorClientes {
+    vector<int> disk;
+    unordered_map<string, File> filesContiguous, filesEncadeados, filesIndexados, filesExtents;
+    unordered_map<string, tuple<int, int>> tabela;
+    int fileID = 0;
+    int estrategia = METODO_CONTIGUO;
+    int proximoArquivo = 0;
+    long long duracao = 0;          // ms de operação simulada
+    SimuladorEventos eventos;
+    DispositivoSimulado dispositivo;
+    EstatisticasOperacao porOperacao[4]; // indexado por TipoOperacaoCarga
+    MetricasVolume metricas;             // acompanha o disco da execução (exportação periódica)
+};
+
+struct ResumoLatencias {
+    long long quantidade = 0;
+    double media = 0;
+    long long p99 = 0;
+};
+
+struct ResultadoClientes {
+    ResumoLatencias total;
+    ResumoLatencias porOperacao[4];
+    long long escritasMetadados[4] = {};
+    int falhas[4] = {};
+    DiagnosticosFalhas diagnosticos;
+    long long tempoVirtual = 0;
+    double esperaMedia = 0;
+    double utilizacao = 0;
+};
+
+ResumoLatencias resumirLatencias(vector<long long>& latencias) {
+    ResumoLatencias resumo;
+    resumo.quantidade = static_cast<long long>(latencias.size());
+    if (latencias.empty()) return resumo;
+    long long soma = 0;
+    for (long long l : latencias) soma += l;
+    resumo.media = (double)soma / latencias.size();
+    auto p99 = latencias.begin() + (latencias.size() * 99) / 100;
+    nth_element(latencias.begin(), p99, latencias.end());
+    resumo.p99 = *p99;
+    return resumo;
+}
+
+// pedido da operação em andamento; devolve o instante em que ela termina
+long long pedirDispositivo(MotorClientes& motor, const ClienteSimulado& cliente, const vector<int>& blocos,
+                           int escritasMetadados) {
+    motor.porOperacao[cliente.operacao].escritasMetadados += escritasMetadados;
+    return submeterAoDispositivo(motor.dispositivo, motor.eventos.relogio, blocos, escritasMetadados).fim;
+}
+
+// blocos do arquivo na ordem em que são lidos (o índice antes dos dados)
+vector<int> blocosParaLeitura(const File& file) {
+    vector<int> blocos = blocosDoArquivo(file);
+    if (file.metodo == METODO_INDEXADO) blocos.insert(blocos.begin(), file.indexBlock);
+    return blocos;
+}
+
+// escolhe e aplica a próxima operação do cliente no disco compartilhado; devolve quando ela termina.
+// Criar e remover gravam a entrada de diretório e o mapa de livres; estender grava também o ponteiro
+// do antigo último bloco (encadeada) ou o bloco índice (indexada)
+long long iniciarOperacaoCliente(MotorClientes& motor, ClienteSimulado& cliente) {
+    int sorteio = cliente.rng() % 100;
+    if (cliente.arquivos.empty()) sorteio = 0;
+    if (sorteio < 30 && cliente.arquivos.size() >= ARQUIVOS_POR_CLIENTE) sorteio = 55; // remove antes de criar
+    cliente.operacao = sorteio < 30 ? CARGA_CRIAR : sorteio < 50 ? CARGA_ESTENDER
+                     : sorteio < 65 ? CARGA_REMOVER : CARGA_LER;
+    long long agora = motor.eventos.relogio;
+
+    auto* mapas = &motor.filesContiguous;
+    if (cliente.operacao == CARGA_CRIAR) {
+        int bytes = 8 + cliente.rng() % 57;
+        int blocos = (bytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+        int metodo = motor.estrategia == ESTRATEGIA_ADAPTATIVA
+                   ? escolherMetodoAdaptativo(motor.disk, blocos, cliente.rng() % 2) : motor.estrategia;
+        string nome = "c" + to_string(cliente.id) + "_" + to_string(motor.proximoArquivo++);
+        ResultadoAlocacao r = alocarArquivoMisto(motor.disk, mapas[0], mapas[1], mapas[2], mapas[3], motor.tabela,
+                                                 metodo, nome, bytes, blocos, motor.fileID);
+        if (r != ALOCACAO_OK) {
+            motor.porOperacao[CARGA_CRIAR].falhas++;
+            return agora;
+        }
+        cliente.arquivos.push_back(nome);
+        return pedirDispositivo(motor, cliente, blocosParaLeitura(mapas[metodo - 1].at(nome)), 2);
+    }
+
+    size_t alvo = cliente.rng() % cliente.arquivos.size();
+    const string& nome = cliente.arquivos[alvo];
+    auto* files = buscarMapaDoArquivo(nome, mapas[0], mapas[1], mapas[2], mapas[3]);
+    if (cliente.operacao == CARGA_ESTENDER) {
+        size_t antes = blocosDoArquivo(files->at(nome)).size();
+        ResultadoAlocacao r = alocarExtensaoMisto(motor.disk, mapas[0], mapas[1], mapas[2], mapas[3], motor.tabela,
+                                                  nome, 4 + cliente.rng() % 29);
+        if (r != ALOCACAO_OK) {
+            motor.porOperacao[CARGA_ESTENDER].falhas++;
+            return agora;
+        }
+        const File& file = files->at(nome);
+        vector<int> blocos = blocosDoArquivo(file);
+        int extra = (file.metodo == METODO_ENCADEADO || file.metodo == METODO_INDEXADO) && blocos.size() > antes;
+        return pedirDispositivo(motor, cliente, vector<int>(blocos.begin() + min(antes, blocos.size()), blocos.end()),
+                                2 + extra);
+    }
+    if (cliente.operacao == CARGA_REMOVER) {
+        removerArquivo(motor.disk, mapas[0], mapas[1], mapas[2], mapas[3], motor.tabela, nome);
+        cliente.arquivos.erase(cliente.arquivos.begin() + alvo);
+        return pedirDispositivo(motor, cliente, {}, 2);
+    }
+    return pedirDispositivo(motor, cliente, blocosParaLeitura(files->at(nome)), 0);
+}
+
+// retoma o cliente no ponto em que ele parou; devolve quando ele quer voltar ou -1 se terminou
+long long retomarCliente(MotorClientes& motor, ClienteSimulado& cliente) {
+    long long agora = motor.eventos.relogio;
+    switch (cliente.etapa) {
+        case CLIENTE_PENSANDO:
+            cliente.etapa = CLIENTE_AGUARDANDO_DISPOSITIVO;
+            cliente.inicioOperacao = agora;
+            return iniciarOperacaoCliente(motor, cliente);
+        case CLIENTE_AGUARDANDO_DISPOSITIVO: {
+            motor.porOperacao[cliente.operacao].latencias.push_back(agora - cliente.inicioOperacao);
+            registrarLatencia(motor.metricas.contadores.latencias[cliente.operacao], agora - cliente.inicioOperacao);
+            exponential_distribution<double> pensar(1.0 / TEMPO_PENSAR_MEDIO);
+            long long proximo = agora + 1 + static_cast<long long>(pensar(cliente.rng));
+            if (proximo >= motor.duracao) break;
+            cliente.etapa = CLIENTE_PENSANDO;
+            return proximo;
+        }
+        case CLIENTE_TERMINADO:
+            break;
+    }
+    cliente.etapa = CLIENTE_TERMINADO;
+    return -1;
+}
+
+ResultadoClientes executarClientes(int numClientes, long long duracao, int estrategia) {
+    EscopoRastro rastro("executarClientes");
+    MotorClientes motor;
+    motor.disk.assign(max(1024, numClientes * BLOCOS_POR_CLIENTE), BLOCO_LIVRE);
+    motor.estrategia = estrategia;
+    motor.duracao = duracao;
+    geradorEmbaralhamento().seed(numClientes);
+
+    vector<ClienteSimulado> clientes(numClientes);
+    for (int c = 0; c < numClientes; ++c) {
+        clientes[c].id = c;
+        clientes[c].rng.seed(104729 * (c + 1));
+        agendarEvento(motor.eventos, clientes[c].rng() % TEMPO_PENSAR_MEDIO, c); // chegadas espalhadas
+    }
+
+    // as métricas deste disco são mantidas pelos próprios alocadores enquanto a execução durar
+    reconstruirMetricas(motor.disk, motor.filesContiguous, motor.filesEncadeados, motor.filesIndexados,
+                        motor.filesExtents, motor.metricas);
+    metricasDoLote = &motor.metricas;
+    string execucao = nomeDoMetodo(estrategia) + "_" + to_string(numClientes) + "_clientes";
+    bool exportando = exportacaoMetricas.formato != EXPORTACAO_DESATIVADA;
+    long long proximaAmostra = 0;
+    for (int c; proximoEvento(motor.eventos, c); ) {
+        // o relógio já está no próximo evento: o estado atual vale para as amostras que ficaram para trás
+        for (; exportando && proximaAmostra < motor.eventos.relogio; proximaAmostra += exportacaoMetricas.periodo)
+            exportarAmostra(motor.metricas, execucao, proximaAmostra);
+        long long proximo = retomarCliente(motor, clientes[c]);
+        if (proximo >= 0) agendarEvento(motor.eventos, proximo, c);
+    }
+    if (exportando) exportarAmostra(motor.metricas, execucao, motor.eventos.relogio);
+    metricasDoLote = nullptr;
+
+    ResultadoClientes resultado;
+    vector<long long> todas;
+    for (int op = CARGA_CRIAR; op <= CARGA_LER; ++op) {
+        EstatisticasOperacao& estatisticas = motor.porOperacao[op];
+        todas.insert(todas.end(), estatisticas.latencias.begin(), estatisticas.latencias.end());
+        resultado.porOperacao[op] = resumirLatencias(estatisticas.latencias);
+        resultado.escritasMetadados[op] = estatisticas.escritasMetadados;
+        resultado.falhas[op] = estatisticas.falhas;
+    }
+    resultado.total = resumirLatencias(todas);
+    resultado.diagnosticos = motor.metricas.contadores.diagnosticos;
+    resultado.tempoVirtual = motor.eventos.relogio;
+    const DispositivoSimulado& dispositivo = motor.dispositivo;
+    resultado.esperaMedia = dispositivo.pedidos ? (double)dispositivo.somaEspera / dispositivo.pedidos : 0.0;
+    resultado.utilizacao = resultado.tempoVirtual ? 100.0 * dispositivo.ocupado / resultado.tempoVirtual : 0.0;
+    return resultado;
+}
+
+void clientesSimuladosMenu(int tipoAlocacao) {
+    int maxClientes;
+    double horas;
+    cout << "Número máximo de clientes simulados: ";
+    cin >> maxClientes;
+    cout << "Horas de operação simulada (ex.: 0.5): ";
+    cin >> horas;
+    if (cin.fail() || maxClientes <= 0 || horas <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Valores inválidos!" << endl;
+        return;
+    }
+    long long duracao = static_cast<long long>(horas * 3600 * 1000);
+
+    vector<int> contagens;
+    for (int c = 1; c < maxClientes; c *= 10) contagens.push_back(c);
+    contagens.push_back(maxClientes);
+
+    int estrategia = tipoAlocacao == METODO_MISTO ? ESTRATEGIA_ADAPTATIVA : tipoAlocacao;
+    cout << "\nClientes simulados (" << nomeDoMetodo(estrategia) << ", " << BLOCOS_POR_CLIENTE
+         << " blocos de disco por cliente, " << TEMPO_PENSAR_MEDIO << " ms de pausa média entre operações)\n"
+         << "Dispositivo: " << modeloTempo.sequencial << " ms por bloco sequencial, " << modeloTempo.aleatorio
+         << " ms por bloco aleatório, " << modeloTempo.metadado << " ms por escrita de metadados\n";
+    cout << setw(9) << "Clientes" << setw(12) << "Operações" << setw(12) << "ops/s" << setw(16) << "Latência (ms)"
+         << setw(10) << "p99" << setw(15) << "Fila (ms)" << setw(15) << "Utilização" << setw(9) << "Falhas"
+         << setw(18) << "Tempo real (s)" << "\n";
+    cout << fixed;
+    ResultadoClientes ultimo;
+    for (int numClientes : contagens) {
+        auto inicio = chrono::steady_clock::now();
+        ResultadoClientes r = executarClientes(numClientes, duracao, estrategia);
+        double real = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        double segundos = r.tempoVirtual / 1000.0;
+        int falhas = 0;
+        for (int f : r.falhas) falhas += f;
+        cout << setprecision(0) << setw(9) << numClientes << setw(11) << r.total.quantidade << setprecision(1)
+             << setw(12) << (segundos > 0 ? r.total.quantidade / segundos : 0.0) << setw(15) << r.total.media
+             << setw(10) << r.total.p99 << setw(15) << r.esperaMedia << setw(14) << r.utilizacao << "%"
+             << setw(9) << falhas << setprecision(2) << setw(17) << real << "\n";
+        ultimo = r;
+    }
+
+    cout << "\nPor operação com " << maxClientes << " cliente(s) em " << setprecision(2) << horas
+         << " h simuladas:\n";
+    cout << setw(10) << left << "Operação" << right << setw(12) << "Quantidade" << setw(16) << "Latência (ms)"
+         << setw(10) << "p99" << setw(18) << "Esc. metadados" << setw(9) << "Falhas" << "\n";
+    for (int op = CARGA_CRIAR; op <= CARGA_LER; ++op) {
+        const ResumoLatencias& resumo = ultimo.porOperacao[op];
+        cout << preencherColuna(NOMES_OPERACOES_CARGA[op], 10) << setprecision(0) << setw(12) << resumo.quantidade
+             << setprecision(1) << setw(15) << resumo.media << setw(10) << resumo.p99 << setw(18)
+             << ultimo.escritasMetadados[op] << setw(9) << ultimo.falhas[op] << "\n";
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    displayDiagnosticoFalhas(ultimo.diagnosticos);
+}
+
+// ---------------- imagem do disco em arquivo (checkpoint / retomada) ----------------
+// layout: superbloco | blocos (int32 por bloco) | bitmap de livres | registros de diretório
+// a imagem é lida e gravada através de mmap quando o sistema oferece (POSIX); o superbloco e o
+// diretório são interpretados direto do mapeamento, sem buffer intermediário, e o vetor de blocos
+// vai para disk[] com um único memcpy (a região inteira é lida). Blocos e bitmap têm checksum próprio
+// e o bitmap é conferido contra disk[] na carga, como uma segunda cópia do estado livre/ocupado
+static_assert(sizeof(int) == sizeof(int32_t), "a imagem grava cada bloco como int32");
+
+constexpr char MAGICO_IMAGEM[8] = {'T', 'D', 'E', 'S', 'I', 'M', 'G', '1'};
+constexpr uint32_t VERSAO_IMAGEM = 2;   // 2: checksum dos blocos e do bitmap
+constexpr uint32_t FLAG_ALOCACAO_ATRASADA = 1u << 0;
+
+struct SuperBloco {
+    char magico[8];
+    uint32_t versao = VERSAO_IMAGEM;
+    uint32_t tamanhoBloco = TAMANHO_BLOCO;
+    uint32_t numBlocos = 0;
+    uint32_t tipoAlocacao = 0;
+    int32_t proximoFileID = 0;    // contador de cores, para os próximos arquivos continuarem a sequência
+    uint32_t numArquivos = 0;
+    uint32_t flags = 0;
+    uint32_t checksumDiretorio = 0; // FNV-1a dos registros de diretório
+    uint32_t checksumBlocos = 0;    // FNV-1a do vetor de blocos e do bitmap
+    uint32_t reservado = 0;
+    uint64_t offsetBlocos = 0;
+    uint64_t offsetBitmap = 0;
+    uint64_t offsetDiretorio = 0;
+    uint64_t tamanhoTotal = 0;
+};
+
+uint32_t checksumFNV(const char* dados, size_t tamanho) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < tamanho; ++i) {
+        hash ^= static_cast<unsigned char>(dados[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void escreverInt(vector<char>& buffer, int32_t valor) {
+    const char* p = reinterpret_cast<const char*>(&valor);
+    buffer.insert(buffer.end(), p, p + sizeof(valor));
+}
+
+void escreverTexto(vector<char>& buffer, const string& texto) {
+    escreverInt(buffer, static_cast<int32_t>(texto.size()));
+    buffer.insert(buffer.end(), texto.begin(), texto.end());
+}
+
+// cursor sobre a região mapeada; qualquer leitura além do fim marca a imagem como inválida
+struct LeitorImagem {
+    const char* atual;
+    const char* fim;
+    bool ok = true;
+};
+
+int32_t lerInt(LeitorImagem& leitor) {
+    int32_t valor = 0;
+    if (leitor.fim - leitor.atual < static_cast<ptrdiff_t>(sizeof(valor))) {
+        leitor.ok = false;
+        return 0;
+    }
+    memcpy(&valor, leitor.atual, sizeof(valor));
+    leitor.atual += sizeof(valor);
+    return valor;
+}
+
+string lerTexto(LeitorImagem& leitor) {
+    int32_t tamanho = lerInt(leitor);
+    if (!leitor.ok || tamanho < 0 || leitor.fim - leitor.atual < tamanho) {
+        leitor.ok = false;
+        return "";
+    }
+    string texto(leitor.atual, leitor.atual + tamanho);
+    leitor.atual += tamanho;
+    return texto;
+}
+
+// registro de diretório: nome, cor, método, entrada da tabela de diretório, campos do File e
+// as listas de blocos/extents (o bloco índice do método indexado não guarda os endereços no disco[])
+void serializarArquivo(vector<char>& buffer, const File& file,
+                        const unordered_map<string, tuple<int, int>>& tabela) {
+    escreverTexto(buffer, file.name);
+    escreverTexto(buffer, file.color);
+    escreverInt(buffer, file.metodo);
+    auto it = tabela.find(file.name);
+    auto entrada = it != tabela.end() ? it->second : make_tuple(-1, 0);
+    escreverInt(buffer, get<0>(entrada));
+    escreverInt(buffer, get<1>(entrada));
+    escreverInt(buffer, file.indexBlock);
+    escreverInt(buffer, file.startBlock);
+    escreverInt(buffer, file.size);
+    escreverInt(buffer, file.sizeBytes);
+    escreverInt(buffer, file.fragmentacao);
+    escreverInt(buffer, static_cast<int32_t>(file.dataBlocks.size()));
+    for (int bloco : file.dataBlocks) escreverInt(buffer, bloco);
+    escreverInt(buffer, static_cast<int32_t>(file.extents.size()));
+    for (const auto& [inicio, tamanho] : file.extents) {
+        escreverInt(buffer, inicio);
+        escreverInt(buffer, tamanho);
+    }
+}
+
+// endereços e tamanhos de um registro lido da imagem: tudo o que as rotinas de remoção, extensão e leitura
+// usam como índice em disk[] tem de estar no disco e bater com size
+bool registroConsistente(const File& file, int numBlocos) {
+    auto noDisco = [numBlocos](long long inicio, long long tamanho) {
+        return inicio >= 0 && tamanho >= 0 && inicio + tamanho <= numBlocos;
+    };
+    if (file.size < 0 || file.size > numBlocos || file.sizeBytes < 0) return false;
+    if (file.startBlock != -1 && !noDisco(file.startBlock, 1)) return false;
+    for (int bloco : file.dataBlocks) {
+        if (!noDisco(bloco, 1)) return false;
+    }
+    switch (file.metodo) {
+        case METODO_CONTIGUO:
+            return file.size == 0 || noDisco(file.startBlock, file.size);
+        case METODO_ENCADEADO:
+            return (int)file.dataBlocks.size() == file.size &&
+                   (file.dataBlocks.empty() || file.startBlock == file.dataBlocks.front());
+        case METODO_INDEXADO:
+            return (int)file.dataBlocks.size() == file.size && file.size <= MAX_ENTRADAS_INDICE &&
+                   noDisco(file.indexBlock, 1);
+        case METODO_EXTENTS: {
+            long long total = 0;
+            for (const auto& [inicio, tamanho] : file.extents) {
+                if (tamanho <= 0 || !noDisco(inicio, tamanho)) return false;
+                total += tamanho;
+            }
+            return total == file.size;
+        }
+    }
+    return false;
+}
+
+bool desserializarArquivo(LeitorImagem& leitor, int numBlocos, File& file, tuple<int, int>& entrada) {
+    file.name = lerTexto(leitor);
+    file.color = lerTexto(leitor);
+    file.metodo = lerInt(leitor);
+    int a = lerInt(leitor);
+    int b = lerInt(leitor);
+    entrada = make_tuple(a, b);
+    file.indexBlock = lerInt(leitor);
+    file.startBlock = lerInt(leitor);
+    file.size = lerInt(leitor);
+    file.sizeBytes = lerInt(leitor);
+    file.fragmentacao = lerInt(leitor);
+    int numDados = lerInt(leitor);
+    if (!leitor.ok || numDados < 0 || numDados > numBlocos) return false;
+    vector<int> blocos(numDados);
+    for (int& bloco : blocos) bloco = lerInt(leitor);
+    file.dataBlocks.assign(blocos.begin(), blocos.end());
+    int numExtents = lerInt(leitor);
+    if (!leitor.ok || numExtents < 0 || numExtents > numBlocos) return false;
+    file.extents.resize(numExtents);
+    for (auto& [inicio, tamanho] : file.extents) {
+        inicio = lerInt(leitor);
+        tamanho = lerInt(leitor);
+    }
+    if (!leitor.ok || file.name.empty()) return false;
+    if (file.metodo < METODO_CONTIGUO || file.metodo > METODO_EXTENTS) return false;
+    return registroConsistente(file, numBlocos);
+}
+
+// região de arquivo aberta para leitura ou escrita; usa mmap quando disponível e,
+// fora de sistemas POSIX, cai para um buffer em memória lido/gravado com fstream
+struct ImagemMapeada {
+    char* dados = nullptr;
+    size_t tamanho = 0;
+    bool escrita = false;
+    string caminho;
+#if SIMULADOR_COM_MMAP
+    int fd = -1;
+#endif
+    vector<char> copia;
+};
+
+bool mapearImagem(const string& caminho, ImagemMapeada& imagem, size_t tamanhoEscrita = 0) {
+    imagem = ImagemMapeada();
+    imagem.caminho = caminho;
+    imagem.escrita = tamanhoEscrita > 0;
+#if SIMULADOR_COM_MMAP
+    int fd = imagem.escrita ? open(caminho.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)
+                            : open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    size_t tamanho = tamanhoEscrita;
+    if (imagem.escrita) {
+        if (ftruncate(fd, static_cast<off_t>(tamanho)) != 0) {
+            close(fd);
+            return false;
+        }
+    } else {
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+        tamanho = static_cast<size_t>(info.st_size);
+    }
+    void* p = mmap(nullptr, tamanho, imagem.escrita ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    imagem.fd = fd;
+    imagem.dados = static_cast<char*>(p);
+    imagem.tamanho = tamanho;
+    return true;
+#else
+    if (imagem.escrita) {
+        imagem.copia.assign(tamanhoEscrita, 0);
+    } else {
+        ifstream entrada(caminho, ios::binary);
+        if (!entrada) return false;
+        imagem.copia.assign(istreambuf_iterator<char>(entrada), istreambuf_iterator<char>());
+        if (imagem.copia.empty()) return false;
+    }
+    imagem.dados = imagem.copia.data();
+    imagem.tamanho = imagem.copia.size();
+    return true;
+#endif
+}
+
+// desfaz o mapeamento; na escrita garante que os dados chegaram ao arquivo
+bool desmapearImagem(ImagemMapeada& imagem) {
+    bool ok = true;
+#if SIMULADOR_COM_MMAP
+    if (imagem.dados) {
+        if (imagem.escrita && msync(imagem.dados, imagem.tamanho, MS_SYNC) != 0) ok = false;
+        munmap(imagem.dados, imagem.tamanho);
+    }
+    if (imagem.fd >= 0) {
+        if (imagem.escrita && fsync(imagem.fd) != 0) ok = false;
+        close(imagem.fd);
+    }
+#else
+    if (imagem.escrita && imagem.dados) {
+        ofstream saida(imagem.caminho, ios::binary | ios::trunc);
+        saida.write(imagem.copia.data(), static_cast<streamsize>(imagem.copia.size()));
+        ok = static_cast<bool>(saida);
+    }
+#endif
+    imagem = ImagemMapeada();
+    return ok;
+}
+
+// grava um checkpoint completo; escreve num arquivo temporário e renomeia no fim,
+// assim uma interrupção no meio nunca estraga o checkpoint anterior
+bool salvarImagemDisco(const string& caminho,
+                       const vector<int>& disk,
+                       const unordered_map<string, File>& filesContiguous,
+                       const unordered_map<string, File>& filesEncadeados,
+                       const unordered_map<string, File>& filesIndexados,
+                       const unordered_map<string, File>& filesExtents,
+                       int tipoAlocacao,
+                       int fileID,
+                       const unordered_map<string, tuple<int, int>>& tabela = tabelaDiretorio) {
+    vector<char> diretorio;
+    uint32_t numArquivos = 0;
+    for (const auto* files : {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents}) {
+        for (const auto& [nome, file] : *files) {
+            serializarArquivo(diretorio, file, tabela);
+            numArquivos++;
+        }
+    }
+
+    SuperBloco super;
+    memcpy(super.magico, MAGICO_IMAGEM, sizeof(super.magico));
+    super.numBlocos = static_cast<uint32_t>(disk.size());
+    super.tipoAlocacao = static_cast<uint32_t>(tipoAlocacao);
+    super.proximoFileID = fileID;
+    super.numArquivos = numArquivos;
+    super.flags = alocacaoAtrasada.ativa ? FLAG_ALOCACAO_ATRASADA : 0;
+    super.checksumDiretorio = checksumFNV(diretorio.data(), diretorio.size());
+    super.offsetBlocos = sizeof(SuperBloco);
+    super.offsetBitmap = super.offsetBlocos + disk.size() * sizeof(int32_t);
+    super.offsetDiretorio = super.offsetBitmap + (disk.size() + 7) / 8;
+    super.tamanhoTotal = super.offsetDiretorio + diretorio.size();
+
+    string temporario = caminho + ".tmp";
+    ImagemMapeada imagem;
+    if (!mapearImagem(temporario, imagem, super.tamanhoTotal)) {
+        cout << "Não foi possível criar a imagem '" << temporario << "'.\n";
+        return false;
+    }
+    memcpy(imagem.dados, &super, sizeof(super));
+    memcpy(imagem.dados + super.offsetBlocos, disk.data(), disk.size() * sizeof(int32_t));
+    // bit ligado = bloco livre
+    unsigned char* bitmap = reinterpret_cast<unsigned char*>(imagem.dados + super.offsetBitmap);
+    memset(bitmap, 0, (disk.size() + 7) / 8);
+    for (size_t i = 0; i < disk.size(); ++i) {
+        if (disk[i] == BLOCO_LIVRE) bitmap[i / 8] |= static_cast<unsigned char>(1u << (i % 8));
+    }
+    if (!diretorio.empty()) memcpy(imagem.dados + super.offsetDiretorio, diretorio.data(), diretorio.size());
+    // blocos e bitmap são contíguos na imagem: um checksum cobre os dois
+    super.checksumBlocos = checksumFNV(imagem.dados + super.offsetBlocos, super.offsetDiretorio - super.offsetBlocos);
+    memcpy(imagem.dados, &super, sizeof(super));
+
+    if (!desmapearImagem(imagem) || rename(temporario.c_str(), caminho.c_str()) != 0) {
+        cout << "Falha ao gravar a imagem '" << caminho << "'.\n";
+        remove(temporario.c_str());
+        return false;
+    }
+    cout << "Checkpoint salvo em '" << caminho << "': " << disk.size() << " blocos, " << numArquivos
+         << " arquivo(s), " << super.tamanhoTotal << " bytes.\n";
+    return true;
 }
 
-// simular leitura dos arquivos para cada método de alocação
-void simularLeituraContiguo(const unordered_map<string, File>& filesContiguous, 
-                            int t_sequencial = 1,
-                            int t_aleatorio = 6) {
-    // solicita o nome do arquivo a ser lido
-    string fileName;
-    cout << "Digite o nome do arquivo para simular a leitura: ";
-    cin >> fileName;
-
-    // verifica se o arquivo existe
-    if (filesContiguous.find(fileName) == filesContiguous.end()) {
-        cout << "Erro: Arquivo não encontrado!" << endl;
-        return;
+// abre uma imagem e substitui todo o estado do simulador; o estado atual só é trocado
+// depois que a imagem inteira foi validada
+bool carregarImagemDisco(const string& caminho,
+                         vector<int>& disk,
+                         unordered_map<string, File>& filesContiguous,
+                         unordered_map<string, File>& filesEncadeados,
+                         unordered_map<string, File>& filesIndexados,
+                         unordered_map<string, File>& filesExtents,
+                         int& tipoAlocacao,
+                         int& fileID) {
+    ImagemMapeada imagem;
+    if (!mapearImagem(caminho, imagem)) {
+        cout << "Não foi possível abrir a imagem '" << caminho << "'.\n";
+        return false;
     }
 
-    const File& file = filesContiguous.at(fileName);
+    SuperBloco super;
+    bool valido = imagem.tamanho >= sizeof(SuperBloco);
+    if (valido) {
+        memcpy(&super, imagem.dados, sizeof(super));
+        valido = memcmp(super.magico, MAGICO_IMAGEM, sizeof(super.magico)) == 0 &&
+                 super.versao == VERSAO_IMAGEM && super.tamanhoBloco == TAMANHO_BLOCO &&
+                 super.numBlocos > 0 && super.tamanhoTotal == imagem.tamanho &&
+                 super.tipoAlocacao >= 1 && super.tipoAlocacao <= METODO_MISTO &&
+                 super.offsetBlocos == sizeof(SuperBloco) &&
+                 super.offsetBitmap == super.offsetBlocos + uint64_t(super.numBlocos) * sizeof(int32_t) &&
+                 super.offsetDiretorio == super.offsetBitmap + (super.numBlocos + 7) / 8 &&
+                 super.offsetDiretorio <= super.tamanhoTotal;
+    }
+    if (valido) {
+        valido = checksumFNV(imagem.dados + super.offsetDiretorio, super.tamanhoTotal - super.offsetDiretorio) ==
+                 super.checksumDiretorio &&
+                 checksumFNV(imagem.dados + super.offsetBlocos, super.offsetDiretorio - super.offsetBlocos) ==
+                 super.checksumBlocos;
+    }
+    if (!valido) {
+        cout << "Imagem '" << caminho << "' inválida ou corrompida.\n";
+        desmapearImagem(imagem);
+        return false;
+    }
 
-    // monta o vetor de blocos do arquivo
-    vector<int> blocosArquivo;
-    for (int i = 0; i < file.size; ++i) {
-        blocosArquivo.push_back(file.startBlock + i);
+    // diretório lido direto do mapeamento
+    unordered_map<string, File> novos[4];
+    unordered_map<string, tuple<int, int>> novaTabela;
+    LeitorImagem leitor{imagem.dados + super.offsetDiretorio, imagem.dados + super.tamanhoTotal};
+    for (uint32_t i = 0; i < super.numArquivos && valido; ++i) {
+        File file;
+        tuple<int, int> entrada;
+        valido = desserializarArquivo(leitor, static_cast<int>(super.numBlocos), file, entrada) &&
+                 !novaTabela.count(file.name);
+        if (valido) {
+            novaTabela[file.name] = entrada;
+            string nome = file.name;
+            novos[file.metodo - 1][nome] = move(file);
+        }
+    }
+    if (!valido || leitor.atual != leitor.fim) {
+        cout << "Imagem '" << caminho << "': diretório inválido.\n";
+        desmapearImagem(imagem);
+        return false;
     }
 
-    if (blocosArquivo.empty()) {
-        cout << "Erro: Arquivo vazio ou inválido!" << endl;
-        return;
+    vector<int> novoDisco(super.numBlocos);
+    memcpy(novoDisco.data(), imagem.dados + super.offsetBlocos, super.numBlocos * sizeof(int32_t));
+
+    // o bitmap tem de concordar com disk[] bloco a bloco (bit ligado = livre; bits além do último bloco zerados)
+    const unsigned char* bitmap = reinterpret_cast<const unsigned char*>(imagem.dados + super.offsetBitmap);
+    for (uint32_t i = 0; i < (super.numBlocos + 7) / 8 * 8 && valido; ++i) {
+        bool livreNoBitmap = (bitmap[i / 8] >> (i % 8)) & 1u;
+        valido = livreNoBitmap == (i < super.numBlocos && novoDisco[i] == BLOCO_LIVRE);
+    }
+    desmapearImagem(imagem);
+    if (!valido) {
+        cout << "Imagem '" << caminho << "': bitmap de livres não corresponde aos blocos.\n";
+        return false;
+    }
+    // ponteiros da encadeada e referências ao início/índice são seguidos como índices em disk[]
+    for (int valor : novoDisco) {
+        if (valor != BLOCO_LIVRE && valor != FIM_CADEIA && (valor < 0 || valor >= static_cast<int>(super.numBlocos))) {
+            cout << "Imagem '" << caminho << "': bloco aponta para fora do disco.\n";
+            return false;
+        }
     }
 
-    int fragmentacao = computeFragmentation(file.size, file.sizeBytes);
+    disk = move(novoDisco);
+
+    filesContiguous = move(novos[0]);
+    filesEncadeados = move(novos[1]);
+    filesIndexados = move(novos[2]);
+    filesExtents = move(novos[3]);
+    tabelaDiretorio = move(novaTabela);
+    tipoAlocacao = static_cast<int>(super.tipoAlocacao);
+    fileID = super.proximoFileID;
+
+    // estado volátil não faz parte da imagem: buffers, cache e readahead recomeçam vazios
+    bool atrasada = (super.flags & FLAG_ALOCACAO_ATRASADA) != 0;
+    alocacaoAtrasada = AlocacaoAtrasada();
+    alocacaoAtrasada.ativa = atrasada;
+    configurarCache(cacheBlocos, cacheBlocos.politica, cacheBlocos.capacidade);
+    estadosReadahead.clear();
+    if (metricasDoDisco(disk)) reconstruirMetricas(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+
+    cout << "Imagem '" << caminho << "' carregada: " << super.numBlocos << " blocos, " << super.numArquivos
+         << " arquivo(s), alocação " << nomeDoMetodo(tipoAlocacao) << ".\n";
+    return true;
+}
 
-    // tempo sequencial: percorre todos os blocos em sequência (1 passo por bloco)
-    int passosSequenciais = (int)blocosArquivo.size();
-    int tempoSequencial = (int)blocosArquivo.size() * t_sequencial;
+string promptCaminhoImagem() {
+    string caminho;
+    cout << "Caminho da imagem do disco: ";
+    cin >> caminho;
+    return caminho;
+}
 
-    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Contígua):\n";
-    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
-    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
-    
-    // imprime a ordem sequencial dos blocos
-    cout << "Ordem sequencial dos blocos: [";
-    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
-        cout << blocosArquivo[i];
-        if (i < blocosArquivo.size() - 1) 
-            cout << ", ";
-    }
+// ---------------- layout colunar para análise offline ----------------
+// mapa de blocos e metadados dos arquivos em colunas, para notebooks carregarem discos de milhões de
+// blocos sem raspar o texto ANSI dos display*. Layout (inteiros little-endian):
+//   "TDECOLN1" | versão | blocos | arquivos | colunas | FNV-1a das colunas   (int32/uint32)
+//   cada coluna: nome (int32 + bytes) | codificação | linhas | bytes do conteúdo (int32) | conteúdo
+// varint = LEB128 sem sinal; inteiros com sinal passam por zigzag antes do varint
+constexpr char MAGICO_COLUNAR[8] = {'T', 'D', 'E', 'C', 'O', 'L', 'N', '1'};
+constexpr int32_t VERSAO_COLUNAR = 1;
+
+enum CodificacaoColuna {
+    COLUNA_VARINT = 1,      // um varint zigzag por linha
+    COLUNA_RLE = 2,         // pares (varint repetições, varint zigzag valor)
+    COLUNA_DELTA_RLE = 3,   // RLE das diferenças para a linha anterior (a primeira é relativa a 0)
+    COLUNA_DICIONARIO = 4,  // varint entradas, cada entrada (varint tamanho + bytes), depois um varint código por linha
+    COLUNA_TEXTO = 5,       // varint tamanho + bytes por linha
+    COLUNA_LISTA_DELTA = 6  // por linha: varint quantidade e as diferenças zigzag entre itens (o primeiro relativo a 0)
+};
 
-    cout << "]\n";
+const char* const NOMES_CODIFICACOES[] = {"?", "varint", "rle", "delta+rle", "dicionário", "texto", "lista delta"};
 
-    // acesso aleatório: solicita o índice do bloco a ser acessado aleatoriamente
-    int indiceDesejado;
-    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
-    cin >> indiceDesejado;
+// estado de cada bloco na coluna bloco.estado
+constexpr int ESTADO_LIVRE = 0;
+constexpr int ESTADO_DADOS = 1;
+constexpr int ESTADO_INDICE = 2;
+constexpr int ESTADO_DESCONHECIDO = 3;
 
-    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
-        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
-    } else {
-        int blocoReal = blocosArquivo[indiceDesejado];
-        int passosAleatorios = 1; // acesso direto
-        int tempoAleatorio = t_aleatorio;
+struct ColunaLayout {
+    string nome;
+    CodificacaoColuna codificacao;
+    long long linhas = 0;
+    long long bytesBrutos = 0;   // o mesmo conteúdo com int32 por valor, para comparar
+    vector<char> dados{};
+};
 
-        cout << "Acesso aleatório ao bloco " << blocoReal << ": " 
-             << passosAleatorios << " passo | " 
-             << tempoAleatorio << " ms\n";
+// acrescenta "repeticoes" linhas com o mesmo valor, juntando com a execução anterior quando possível
+void acrescentarExecucao(vector<pair<long long, long long>>& execucoes, long long valor, long long repeticoes) {
+    if (repeticoes <= 0) return;
+    if (!execucoes.empty() && execucoes.back().first == valor) execucoes.back().second += repeticoes;
+    else execucoes.push_back({valor, repeticoes});
+}
+
+ColunaLayout colunaRle(const string& nome, const vector<pair<long long, long long>>& execucoes,
+                       CodificacaoColuna codificacao = COLUNA_RLE) {
+    ColunaLayout coluna{nome, codificacao};
+    for (const auto& [valor, repeticoes] : execucoes) {
+        escreverVarint(coluna.dados, repeticoes);
+        escreverVarint(coluna.dados, zigzag(valor));
+        coluna.linhas += repeticoes;
     }
+    coluna.bytesBrutos = coluna.linhas * 4;
+    return coluna;
 }
 
-void simularLeituraEncadeado(const vector<int>& disk, 
-                             const unordered_map<string, File>& filesEncadeados, 
-                             int t_sequencial = 1,
-                             int t_aleatorio = 5) {
-    // solicita o nome do arquivo a ser lido
-    string fileName;
-    cout << "Digite o nome do arquivo para simular a leitura: ";
-    cin >> fileName;
+ColunaLayout colunaVarint(const string& nome, const vector<long long>& valores) {
+    ColunaLayout coluna{nome, COLUNA_VARINT};
+    for (long long valor : valores) escreverVarint(coluna.dados, zigzag(valor));
+    coluna.linhas = static_cast<long long>(valores.size());
+    coluna.bytesBrutos = coluna.linhas * 4;
+    return coluna;
+}
 
-    // verifica se o arquivo existe
-    if (filesEncadeados.find(fileName) == filesEncadeados.end()) {
-        cout << "Erro: Arquivo não encontrado!" << endl;
-        return;
+ColunaLayout colunaTexto(const string& nome, const vector<string>& textos) {
+    ColunaLayout coluna{nome, COLUNA_TEXTO};
+    for (const string& texto : textos) {
+        escreverVarint(coluna.dados, texto.size());
+        coluna.dados.insert(coluna.dados.end(), texto.begin(), texto.end());
+        coluna.bytesBrutos += 4 + static_cast<long long>(texto.size());
     }
+    coluna.linhas = static_cast<long long>(textos.size());
+    return coluna;
+}
 
-    const File& file = filesEncadeados.at(fileName);
-
-    // monta o vetor de blocos seguindo os ponteiros
-    vector<int> blocosArquivo;
-    int blocoAtual = file.dataBlocks.empty() ? -1 : file.dataBlocks.front();
+// códigos na ordem em que cada texto aparece pela primeira vez
+ColunaLayout colunaDicionario(const string& nome, const vector<string>& textos) {
+    ColunaLayout coluna{nome, COLUNA_DICIONARIO};
+    unordered_map<string, uint64_t> codigos;
+    vector<const string*> entradas;
+    vector<uint64_t> linhas;
+    for (const string& texto : textos) {
+        auto [it, novo] = codigos.emplace(texto, entradas.size());
+        if (novo) entradas.push_back(&it->first);
+        linhas.push_back(it->second);
+        coluna.bytesBrutos += 4 + static_cast<long long>(texto.size());
+    }
+    escreverVarint(coluna.dados, entradas.size());
+    for (const string* entrada : entradas) {
+        escreverVarint(coluna.dados, entrada->size());
+        coluna.dados.insert(coluna.dados.end(), entrada->begin(), entrada->end());
+    }
+    for (uint64_t codigo : linhas) escreverVarint(coluna.dados, codigo);
+    coluna.linhas = static_cast<long long>(textos.size());
+    return coluna;
+}
 
-    while (blocoAtual != -1 && blocoAtual != -2) { //fim da cadeia
-        blocosArquivo.push_back(blocoAtual);
-        blocoAtual = disk[blocoAtual]; // próximo bloco
+void acrescentarListaDelta(ColunaLayout& coluna, const vector<int>& lista) {
+    escreverVarint(coluna.dados, lista.size());
+    long long anterior = 0;
+    for (int valor : lista) {
+        escreverVarint(coluna.dados, zigzag(valor - anterior));
+        anterior = valor;
     }
+    coluna.linhas++;
+    coluna.bytesBrutos += 4 * (1 + static_cast<long long>(lista.size()));
+}
 
-    if (blocosArquivo.empty()) {
-        cout << "Erro: Arquivo vazio ou inválido!" << endl;
-        return;
+// monta as colunas; as de bloco vêm dos trechos do mapa compacto (sem expandir blocos), menos bloco.valor,
+// que é o próprio vetor do disco (ponteiros da encadeada, início da contígua) em delta+RLE
+vector<ColunaLayout> montarColunasLayout(const vector<int>& disk,
+                                         initializer_list<const unordered_map<string, File>*> mapas) {
+    vector<const File*> arquivos;
+    for (const auto* files : mapas)
+        for (const auto& [nome, file] : *files) arquivos.push_back(&file);
+    sort(arquivos.begin(), arquivos.end(), [](const File* a, const File* b) { return a->name < b->name; });
+    unordered_map<const File*, long long> linhaDoArquivo;
+    for (size_t i = 0; i < arquivos.size(); ++i) linhaDoArquivo[arquivos[i]] = static_cast<long long>(i);
+
+    vector<pair<long long, long long>> estados, donos, valores;
+    int posicao = 0;
+    for (const TrechoMapa& trecho : trechosDoMapa(disk, mapas)) {
+        if (trecho.inicio > posicao) { // blocos ocupados sem dono conhecido
+            acrescentarExecucao(estados, ESTADO_DESCONHECIDO, trecho.inicio - posicao);
+            acrescentarExecucao(donos, -1, trecho.inicio - posicao);
+        }
+        int estado = trecho.dono == nullptr ? ESTADO_LIVRE : trecho.indice ? ESTADO_INDICE : ESTADO_DADOS;
+        acrescentarExecucao(estados, estado, trecho.tamanho);
+        acrescentarExecucao(donos, trecho.dono == nullptr ? -1 : linhaDoArquivo[trecho.dono], trecho.tamanho);
+        posicao = trecho.inicio + trecho.tamanho;
+    }
+    acrescentarExecucao(estados, ESTADO_DESCONHECIDO, static_cast<long long>(disk.size()) - posicao);
+    acrescentarExecucao(donos, -1, static_cast<long long>(disk.size()) - posicao);
+    long long anterior = 0;
+    for (int valor : disk) {
+        acrescentarExecucao(valores, valor - anterior, 1);
+        anterior = valor;
     }
 
-    int fragmentacao = computeFragmentation(file.size,  file.sizeBytes);
+    vector<string> nomes, metodos, cores;
+    vector<long long> inicios, indices, blocos, bytes, fragmentacoes, trechos;
+    ColunaLayout listas{"arquivo.listaBlocos", COLUNA_LISTA_DELTA};
+    for (const File* file : arquivos) {
+        vector<int> lista = blocosDoArquivo(*file);
+        nomes.push_back(file->name);
+        metodos.push_back(nomeDoMetodo(file->metodo));
+        cores.push_back(file->color);
+        inicios.push_back(lista.empty() ? -1 : lista.front());
+        indices.push_back(file->indexBlock);
+        blocos.push_back(static_cast<long long>(lista.size()));
+        bytes.push_back(file->sizeBytes);
+        fragmentacoes.push_back(computeFragmentation(file->size, file->sizeBytes));
+        long long trechosDoArquivo = lista.empty() ? 0 : 1;
+        for (size_t i = 1; i < lista.size(); ++i) trechosDoArquivo += lista[i] != lista[i - 1] + 1;
+        trechos.push_back(trechosDoArquivo);
+        acrescentarListaDelta(listas, lista);
+    }
 
-     // custo sequencial: blocos + saltos de ponteiro
-    int passosSequenciais = (int)blocosArquivo.size() * 2 - 1; 
-    int tempoSequencial = (int)blocosArquivo.size() * t_sequencial;
+    vector<ColunaLayout> colunas;
+    colunas.push_back(colunaRle("bloco.estado", estados));
+    colunas.push_back(colunaRle("bloco.arquivo", donos));
+    colunas.push_back(colunaRle("bloco.valor", valores, COLUNA_DELTA_RLE));
+    colunas.push_back(colunaTexto("arquivo.nome", nomes));
+    colunas.push_back(colunaDicionario("arquivo.metodo", metodos));
+    colunas.push_back(colunaDicionario("arquivo.cor", cores));
+    colunas.push_back(colunaVarint("arquivo.inicio", inicios));
+    colunas.push_back(colunaVarint("arquivo.indice", indices));
+    colunas.push_back(colunaVarint("arquivo.blocos", blocos));
+    colunas.push_back(colunaVarint("arquivo.bytes", bytes));
+    colunas.push_back(colunaVarint("arquivo.fragInterna", fragmentacoes));
+    colunas.push_back(colunaVarint("arquivo.trechos", trechos));
+    colunas.push_back(move(listas));
+    return colunas;
+}
 
-    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Encadeada):\n";
-    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
-    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
+bool exportarLayoutColunar(const string& caminho, const vector<int>& disk,
+                           initializer_list<const unordered_map<string, File>*> mapas) {
+    EscopoRastro rastro("exportarLayoutColunar");
+    vector<ColunaLayout> colunas = montarColunasLayout(disk, mapas);
+    vector<char> corpo;
+    for (const ColunaLayout& coluna : colunas) {
+        escreverTexto(corpo, coluna.nome);
+        escreverInt(corpo, coluna.codificacao);
+        escreverInt(corpo, static_cast<int32_t>(coluna.linhas));
+        escreverInt(corpo, static_cast<int32_t>(coluna.dados.size()));
+        corpo.insert(corpo.end(), coluna.dados.begin(), coluna.dados.end());
+    }
+    vector<char> cabecalho(MAGICO_COLUNAR, MAGICO_COLUNAR + sizeof(MAGICO_COLUNAR));
+    escreverInt(cabecalho, VERSAO_COLUNAR);
+    escreverInt(cabecalho, static_cast<int32_t>(disk.size()));
+    escreverInt(cabecalho, static_cast<int32_t>(colunas[3].linhas));
+    escreverInt(cabecalho, static_cast<int32_t>(colunas.size()));
+    escreverInt(cabecalho, static_cast<int32_t>(checksumFNV(corpo.data(), corpo.size())));
+
+    string temporario = caminho + ".tmp";
+    {
+        ofstream saida(temporario, ios::binary | ios::trunc);
+        saida.write(cabecalho.data(), static_cast<streamsize>(cabecalho.size()));
+        saida.write(corpo.data(), static_cast<streamsize>(corpo.size()));
+        if (!saida) {
+            cout << "Não foi possível gravar '" << temporario << "'.\n";
+            remove(temporario.c_str());
+            return false;
+        }
+    }
+    if (rename(temporario.c_str(), caminho.c_str()) != 0) {
+        cout << "Falha ao gravar o layout '" << caminho << "'.\n";
+        remove(temporario.c_str());
+        return false;
+    }
 
-    // imprime ordem sequencial dos blocos
-    cout << "Ordem sequencial dos blocos: [";
-    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
-        cout << blocosArquivo[i];
-        if (i < blocosArquivo.size() - 1) cout << ", ";
+    long long brutos = 0;
+    cout << "Layout colunar salvo em '" << caminho << "': " << disk.size() << " blocos, " << colunas[3].linhas
+         << " arquivo(s), " << cabecalho.size() + corpo.size() << " bytes.\n";
+    cout << left << setw(22) << "Coluna" << setw(14) << "Codificação" << right << setw(10) << "Linhas"
+         << setw(12) << "Bytes" << setw(12) << "int32" << "\n";
+    for (const ColunaLayout& coluna : colunas) {
+        cout << left << setw(22) << coluna.nome << preencherColuna(NOMES_CODIFICACOES[coluna.codificacao], 14)
+             << right << setw(10) << coluna.linhas << setw(12) << coluna.dados.size() << setw(12)
+             << coluna.bytesBrutos << "\n";
+        brutos += coluna.bytesBrutos;
     }
+    cout << "Total: " << corpo.size() << " bytes de colunas contra " << brutos << " com int32 por valor ("
+         << fixed << setprecision(1) << (brutos ? 100.0 * corpo.size() / brutos : 0.0) << "%).\n";
+    cout.unsetf(ios::fixed);
+    return true;
+}
 
-    cout << "]\n";
+void exportacaoLayoutMenu(const vector<int>& disk,
+                          const unordered_map<string, File>& filesContiguous,
+                          const unordered_map<string, File>& filesEncadeados,
+                          const unordered_map<string, File>& filesIndexados,
+                          const unordered_map<string, File>& filesExtents) {
+    string caminho;
+    cout << "Caminho do layout colunar: ";
+    cin >> caminho;
+    exportarLayoutColunar(caminho, disk, {&filesContiguous, &filesEncadeados, &filesIndexados, &filesExtents});
+}
 
-    // solicita o índice do bloco a ser acessado aleatoriamente
-    int indiceDesejado;
-    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
-    cin >> indiceDesejado;
+// ---------------- envelhecimento do volume (aging) ----------------
+// aplica meses de criações, extensões e remoções a um disco vazio, sem desenhar nada, e grava a imagem
+// envelhecida para os benchmarks partirem de um volume realisticamente fragmentado. A carga segue a
+// linha do Impressions e do envelhecimento de Smith e Seltzer: tamanhos com corpo lognormal e cauda de
+// Pareto, arquivos novos morrem mais cedo que os antigos e o volume oscila em torno de uma ocupação alvo
+constexpr double MEDIANA_ARQUIVO_BYTES = 24.0;  // corpo lognormal dos tamanhos (3 blocos)
+constexpr double DESVIO_LOG_ARQUIVO = 1.0;
+constexpr double FRACAO_CAUDA_PARETO = 0.1;     // arquivos grandes, com tamanho de Pareto
+constexpr double MINIMO_PARETO_BYTES = 64.0;
+constexpr double ALFA_PARETO = 1.3;
+constexpr double CHANCE_ARQUIVO_CRESCER = 0.3;  // para a estratégia adaptativa
+constexpr long long MS_POR_DIA = 24LL * 3600 * 1000;
+
+struct ConfiguracaoEnvelhecimento {
+    int numBlocos = 0;
+    int estrategia = METODO_CONTIGUO;
+    int dias = 180;
+    int ocupacaoAlvo = 70;        // % dos blocos
+    int operacoesPorDia = 0;
+    unsigned semente = 1;
+};
 
-    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
-        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
+struct MotorEnvelhecimento {
+    vector<int> disk;
+    unordered_map<string, File> filesContiguous, filesEncadeados, filesIndexados, filesExtents;
+    unordered_map<string, tuple<int, int>> tabela;
+    int fileID = 0;
+    long long proximoArquivo = 0;
+    vector<string> vivos;         // em ordem de criação: os do fim são os mais novos
+    MetricasVolume metricas;
+    mt19937 rng;
+};
+
+int tamanhoArquivoEnvelhecimento(mt19937& rng, int maxBytes) {
+    uniform_real_distribution<double> uniforme(0.0, 1.0);
+    double bytes;
+    if (uniforme(rng) < FRACAO_CAUDA_PARETO) {
+        bytes = MINIMO_PARETO_BYTES / pow(1.0 - uniforme(rng), 1.0 / ALFA_PARETO);
     } else {
-        // tempo de acesso aleatório: depende da posição (precisa percorrer a cadeia até o bloco desejado)
-        int blocoReal = blocosArquivo[indiceDesejado];
-        int passosAleatorios = (indiceDesejado + 1) * 2 - 1;
-        int tempoAleatorio = (indiceDesejado + 1) * t_aleatorio;
+        lognormal_distribution<double> corpo(log(MEDIANA_ARQUIVO_BYTES), DESVIO_LOG_ARQUIVO);
+        bytes = corpo(rng);
+    }
+    return static_cast<int>(max(1.0, min<double>(bytes, maxBytes)));
+}
 
-        cout << "Acesso aleatório ao bloco " << blocoReal << ": " << passosAleatorios 
-             << " passos | " << tempoAleatorio << " ms\n";
+// metade das remoções atinge o décimo mais novo dos arquivos; as demais, qualquer arquivo
+size_t escolherArquivoRemovido(MotorEnvelhecimento& motor) {
+    size_t vivos = motor.vivos.size();
+    size_t jovens = max<size_t>(1, vivos / 10);
+    if (motor.rng() % 2 == 0) return vivos - 1 - motor.rng() % jovens;
+    return motor.rng() % vivos;
+}
 
-        // percurso da cadeia encadeada até o bloco desejado
-        cout << "Percurso até o bloco desejado: ";
-        for (int i = 0; i <= indiceDesejado; ++i) {
-            cout << blocosArquivo[i];
-            
-            if (i < indiceDesejado) 
-                cout << " -> ";
+void aplicarDiaDeEnvelhecimento(MotorEnvelhecimento& motor, const ConfiguracaoEnvelhecimento& config) {
+    auto* mapas = &motor.filesContiguous;
+    // a indexada não comporta arquivos maiores que o bloco índice; os demais métodos, até 1/16 do disco
+    int maxBytes = config.estrategia == METODO_INDEXADO ? MAX_ENTRADAS_INDICE * TAMANHO_BLOCO
+                 : max(TAMANHO_BLOCO, config.numBlocos / 16 * TAMANHO_BLOCO);
+    for (int op = 0; op < config.operacoesPorDia; ++op) {
+        int ocupacao = 100 - (int)(100LL * motor.metricas.blocosLivres / config.numBlocos);
+        int sorteio = motor.rng() % 100;
+        // abaixo do alvo o volume enche (60% criações); acima, esvazia (60% remoções)
+        int limiteCriar = ocupacao < config.ocupacaoAlvo ? 60 : 25;
+        int limiteEstender = limiteCriar + (ocupacao < config.ocupacaoAlvo ? 20 : 15);
+        if (motor.vivos.empty()) sorteio = 0;
+
+        if (sorteio < limiteCriar) {
+            int bytes = tamanhoArquivoEnvelhecimento(motor.rng, maxBytes);
+            int blocos = (bytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+            bool vaiCrescer = uniform_real_distribution<double>(0.0, 1.0)(motor.rng) < CHANCE_ARQUIVO_CRESCER;
+            int metodo = config.estrategia == ESTRATEGIA_ADAPTATIVA
+                       ? escolherMetodoAdaptativo(motor.disk, blocos, vaiCrescer) : config.estrategia;
+            string nome = "g" + to_string(motor.proximoArquivo++);
+            if (alocarArquivoMisto(motor.disk, mapas[0], mapas[1], mapas[2], mapas[3], motor.tabela, metodo, nome,
+                                   bytes, blocos, motor.fileID) == ALOCACAO_OK) {
+                motor.vivos.push_back(nome);
+            }
+        } else if (sorteio < limiteEstender) {
+            // acréscimos pequenos (logs, anexos) a um arquivo qualquer
+            const string& nome = motor.vivos[motor.rng() % motor.vivos.size()];
+            int bytes = tamanhoArquivoEnvelhecimento(motor.rng, maxBytes) / 2 + 1;
+            alocarExtensaoMisto(motor.disk, mapas[0], mapas[1], mapas[2], mapas[3], motor.tabela, nome, bytes);
+        } else {
+            size_t alvo = escolherArquivoRemovido(motor);
+            removerArquivo(motor.disk, mapas[0], mapas[1], mapas[2], mapas[3], motor.tabela, motor.vivos[alvo]);
+            motor.vivos.erase(motor.vivos.begin() + alvo);
         }
-
-        cout << "\n";
     }
 }
 
-void simularLeituraIndexado(const unordered_map<string, File>& filesIndexados, 
-                            int t_sequencial = 1,
-                            int t_aleatorio = 5,
-                            int t_indice = 5) {
-    // solicita o nome do arquivo a ser lido
-    string fileName;
-    cout << "Digite o nome do arquivo para simular a leitura: ";
-    cin >> fileName;
+void displayDiaEnvelhecimento(int dia, const MetricasVolume& m, int numBlocos) {
+    const ContadoresVolume& c = m.contadores;
+    long long falhas = 0;
+    for (long long f : c.falhas) falhas += f;
+    cout << setw(6) << dia << setw(10) << m.arquivos << setw(11) << 100.0 * (numBlocos - m.blocosLivres) / numBlocos
+         << "%" << setw(14) << m.trechosLivres.size() << setw(14) << maiorTrechoLivre(m) << setw(15)
+         << indiceFragExterna(m) << setw(18) << (m.arquivos ? (double)m.trechosDosArquivos / m.arquivos : 0.0)
+         << setw(10) << falhas << "\n";
+}
 
-    // verifica se o arquivo existe
-    if (filesIndexados.find(fileName) == filesIndexados.end()) {
-        cout << "Arquivo não encontrado." << endl;
-        return;
+void executarEnvelhecimento(MotorEnvelhecimento& motor, const ConfiguracaoEnvelhecimento& config) {
+    EscopoRastro rastro("executarEnvelhecimento");
+    motor.disk.assign(config.numBlocos, BLOCO_LIVRE);
+    motor.rng.seed(config.semente);
+    geradorEmbaralhamento().seed(config.semente);
+    reconstruirMetricas(motor.disk, motor.filesContiguous, motor.filesEncadeados, motor.filesIndexados,
+                        motor.filesExtents, motor.metricas);
+    metricasDoLote = &motor.metricas;
+    string execucao = "envelhecimento_" + nomeDoMetodo(config.estrategia);
+    bool exportando = exportacaoMetricas.formato != EXPORTACAO_DESATIVADA;
+    long long proximaAmostra = 0;
+
+    cout << setw(6) << "Dia" << setw(10) << "Arquivos" << setw(12) << "Ocupação" << setw(14) << "Trechos liv."
+         << setw(14) << "Maior trecho" << setw(15) << "Frag. externa" << setw(18) << "Trechos/arquivo"
+         << setw(10) << "Falhas" << "\n";
+    cout << fixed << setprecision(2);
+    for (int dia = 1; dia <= config.dias; ++dia) {
+        aplicarDiaDeEnvelhecimento(motor, config);
+        long long agora = dia * MS_POR_DIA;
+        for (; exportando && proximaAmostra <= agora; proximaAmostra += exportacaoMetricas.periodo)
+            exportarAmostra(motor.metricas, execucao, proximaAmostra);
+        if (dia % 30 == 0 || dia == config.dias) displayDiaEnvelhecimento(dia, motor.metricas, config.numBlocos);
     }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    metricasDoLote = nullptr;
+}
 
-    const File& file = filesIndexados.at(fileName);
-    const vector<int>& blocosArquivo = file.dataBlocks;
-
-    if (blocosArquivo.empty()) {
-        cout << "Erro: Arquivo vazio ou inválido!" << endl;
+void envelhecimentoMenu(const vector<int>& disk, int tipoAlocacao) {
+    ConfiguracaoEnvelhecimento config;
+    config.numBlocos = static_cast<int>(disk.size());
+    config.estrategia = tipoAlocacao == METODO_MISTO ? ESTRATEGIA_ADAPTATIVA : tipoAlocacao;
+    string caminho;
+    // o limite de 128 blocos do menu inicial vale para o desenho no terminal; o envelhecimento não desenha
+    int numBlocos;
+    cout << "Blocos do disco envelhecido (0 = " << config.numBlocos << ", o tamanho do disco atual): ";
+    cin >> numBlocos;
+    if (numBlocos > 0) config.numBlocos = numBlocos;
+    cout << "Dias de uso a simular (ex.: 180): ";
+    cin >> config.dias;
+    cout << "Ocupação alvo do volume (%): ";
+    cin >> config.ocupacaoAlvo;
+    cout << "Operações por dia (0 = " << max(1, config.numBlocos / 8) << ", 1/8 dos blocos): ";
+    cin >> config.operacoesPorDia;
+    cout << "Semente: ";
+    cin >> config.semente;
+    if (cin.fail() || config.dias <= 0 || config.ocupacaoAlvo <= 0 || config.ocupacaoAlvo >= 100 ||
+        config.operacoesPorDia < 0 || numBlocos < 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Valores inválidos!" << endl;
         return;
     }
-
-    int fragmentacao = computeFragmentation(file.size, file.sizeBytes);
-
-    // leitura sequencial: ler bloco de índice + percorrer todos os blocos do arquivo
-    int passosSequenciais = 1 + (int)blocosArquivo.size();
-    int tempoSequencial = t_indice + (int)blocosArquivo.size() * t_sequencial;
-
-    cout << "\nSimulação de leitura do arquivo '" << fileName << "' (Indexada):\n";
-    cout << "Fragmentação interna: " << fragmentacao << " bytes\n";
-    cout << "Leitura sequencial: " << passosSequenciais << " passos | " << tempoSequencial << " ms\n";
-
-    // imprime a ordem sequencial dos blocos
-    cout << "Ordem sequencial dos blocos: [";
-    for (size_t i = 0; i < blocosArquivo.size(); ++i) {
-        cout << blocosArquivo[i];
-        if (i < blocosArquivo.size() - 1) cout << ", ";
+    if (config.operacoesPorDia == 0) config.operacoesPorDia = max(1, config.numBlocos / 8);
+    caminho = promptCaminhoImagem();
+
+    cout << "\nEnvelhecendo um disco vazio de " << config.numBlocos << " blocos (" << nomeDoMetodo(config.estrategia)
+         << ", " << config.operacoesPorDia << " operações por dia, ocupação alvo de " << config.ocupacaoAlvo
+         << "%):\n";
+    auto inicio = chrono::steady_clock::now();
+    MotorEnvelhecimento motor;
+    executarEnvelhecimento(motor, config);
+    double real = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    const ContadoresVolume& c = motor.metricas.contadores;
+    cout << c.criacoes << " criação(ões), " << c.extensoes << " extensão(ões) e " << c.remocoes
+         << " remoção(ões) em " << fixed << setprecision(2) << real << " s.\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    displayDiagnosticoFalhas(c.diagnosticos, 1);
+
+    if (salvarImagemDisco(caminho, motor.disk, motor.filesContiguous, motor.filesEncadeados, motor.filesIndexados,
+                          motor.filesExtents, tipoAlocacao, motor.fileID, motor.tabela)) {
+        cout << "Carregue o volume envelhecido pela opção 11 ou com ./TDE_Simulador_Arquivos " << caminho << endl;
     }
+}
 
-    cout << "]\n";
-
-    // acesso aleatório: índice + bloco
-    int indiceDesejado;
-    cout << "Digite o índice do bloco que deseja acessar (0 = primeiro bloco): ";
-    cin >> indiceDesejado;
-
-    if (indiceDesejado < 0 || indiceDesejado >= static_cast<int>(blocosArquivo.size())) {
-        cout << "Índice inválido. Digite um valor entre 0 e " << static_cast<int>(blocosArquivo.size()) - 1 << ".\n";
-    } else {
-        int blocoReal = blocosArquivo[indiceDesejado];
-        int tempoBloco = t_indice + t_aleatorio;
-
-        cout << "Tempo para acessar o bloco " << blocoReal << " aleatoriamente: " << tempoBloco << " ms\n";
-
-        // percurso do bloco de índice até o bloco desejado
-        cout << "Percurso até o bloco desejado: bloco índice -> " << blocoReal << "\n";
+void rastreamentoMenu() {
+    bool ativo = rastreamento.ativo.load(memory_order_relaxed);
+    int opcao;
+    cout << "Rastreamento " << (ativo ? "ativo" : "desativado") << ": 1 - ativar (limpa os eventos), "
+         << "2 - gravar e desativar, 0 - desativar sem gravar: ";
+    cin >> opcao;
+    if (cin.fail() || opcao < 0 || opcao > 2) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Opção inválida!" << endl;
+        return;
+    }
+    if (opcao == 1) {
+        ativarRastreamento();
+        cout << "Rastreamento ativado (guarda os " << CAPACIDADE_RASTRO << " eventos mais recentes)." << endl;
+        return;
+    }
+    rastreamento.ativo.store(false, memory_order_release);
+    if (opcao == 0) {
+        cout << "Rastreamento desativado." << endl;
+        return;
+    }
+    string caminho;
+    cout << "Arquivo de destino (JSON): ";
+    cin >> caminho;
+    long long gravados = gravarRastro(caminho);
+    if (gravados < 0) {
+        cout << "Erro: não foi possível gravar em " << caminho << endl;
+        return;
     }
+    uint64_t registrados = rastreamento.proximo.load(memory_order_relaxed);
+    cout << gravados << " evento(s) gravado(s) em " << caminho;
+    if (registrados > CAPACIDADE_RASTRO) cout << " (" << registrados - CAPACIDADE_RASTRO << " mais antigos descartados)";
+    cout << "; abra em chrome://tracing ou ui.perfetto.dev." << endl;
 }
 
 // menu principal do simulador com as opções de executar operações em arquivos, permitindo 
 // o usuário escolher o método de alocação e tamanho do disco
-int main() {
-    int diskSizeBytes;
-    
-    do {
-        cout << "===== SIMULADOR DE ALOCAÇÃO DE ARQUIVOS =====\n";
-        cout << "  Métodos: Contígua | Encadeada | Indexada\n";
-        cout << "   Simulação com blocos lógicos de 8 bytes\n";
-        cout << "Determine o tamanho do disco em bytes (mínimo 16 (2 blocos) | máximo 1024 bytes (128 blocos)): ";
-        cin >> diskSizeBytes;
-
-        if (cin.fail()) { // se não for número
-            cin.clear(); // limpa o estado de erro
-            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // descarta input inválido
-            cout << "Entrada inválida! Por favor, digite um número.\n";
-            diskSizeBytes = 0; // força a repetição do loop
-            continue; 
-    }
-        // valida o tamanho do disco
-        if (diskSizeBytes < 16 || diskSizeBytes > 1024) {
-            cout << "Tamanho inválido! Digite novamente, mínimo 16 e máximo 1024.\n";
-        }
-    } while (diskSizeBytes < 16 || diskSizeBytes > 1024);
-    
-    // calcula o número de blocos do disco (tamanho do bloco fixo de 8 bytes)
-    int diskSizeBlocks = (diskSizeBytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
-    
-    cout << "Disco de " << diskSizeBytes << " bytes criado com " << diskSizeBlocks 
-         << " blocos de " << TAMANHO_BLOCO << " bytes. ";
-    
-    // inicializa o disco com -1 (bloco livre)
-    vector<int> disk(diskSizeBlocks, -1);
-    
-    cout << "\nEstado inicial do disco:" << endl;
-    for (int i = 0; i < diskSizeBlocks; ++i) {
-        cout << "[" << i << "] ░" << endl;
-    }
+int main(int argc, char* argv[]) {
+    vector<int> disk;
 
     // contador para gerar cores únicas para os arquivos
     int fileID = 0;
@@ -1156,27 +7464,79 @@ int main() {
     unordered_map<string, File> filesContiguous;
     unordered_map<string, File> filesEncadeados;
     unordered_map<string, File> filesIndexados;
+    unordered_map<string, File> filesExtents;
 
-    int tipoAlocacao;
-    while (true){
-        cout << "Escolha o tipo de alocação:\n1. Contígua\n2. Encadeada\n3. Indexada\n";
-        cin >> tipoAlocacao;
-    
-        if (cin.fail()) { // entrada não numérica
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << "Entrada inválida! Digite um número entre 1 e 3.\n";
-            continue;
-        }
+    int tipoAlocacao = 0;
 
-        if (tipoAlocacao < 1 || tipoAlocacao > 3) {
-            cout << "Opção inválida! Digite 1, 2 ou 3.\n";
-            continue;
+    // ./TDE_Simulador_Arquivos <imagem> retoma um checkpoint salvo pela opção 10
+    bool retomado = argc > 1 && carregarImagemDisco(argv[1], disk, filesContiguous, filesEncadeados,
+                                                   filesIndexados, filesExtents, tipoAlocacao, fileID);
+
+    if (!retomado) {
+        int diskSizeBytes;
+    
+        do {
+            cout << "===== SIMULADOR DE ALOCAÇÃO DE ARQUIVOS =====\n";
+            cout << "  Métodos: Contígua | Encadeada | Indexada | Extents | Mista\n";
+            cout << "   Simulação com blocos lógicos de 8 bytes\n";
+            cout << "Determine o tamanho do disco em bytes (mínimo 16 (2 blocos) | máximo 1024 bytes (128 blocos)): ";
+            cin >> diskSizeBytes;
+
+            if (cin.fail()) { // se não for número
+                cin.clear(); // limpa o estado de erro
+                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // descarta input inválido
+                cout << "Entrada inválida! Por favor, digite um número.\n";
+                diskSizeBytes = 0; // força a repetição do loop
+                continue; 
         }
-            break;
+            // valida o tamanho do disco
+            if (diskSizeBytes < 16 || diskSizeBytes > 1024) {
+                cout << "Tamanho inválido! Digite novamente, mínimo 16 e máximo 1024.\n";
+            }
+        } while (diskSizeBytes < 16 || diskSizeBytes > 1024);
+    
+        // calcula o número de blocos do disco (tamanho do bloco fixo de 8 bytes)
+        int diskSizeBlocks = (diskSizeBytes + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    
+        cout << "Disco de " << diskSizeBytes << " bytes criado com " << diskSizeBlocks 
+             << " blocos de " << TAMANHO_BLOCO << " bytes. ";
+    
+        // inicializa o disco com -1 (bloco livre)
+        disk.assign(diskSizeBlocks, -1);
+    
+        cout << "\nEstado inicial do disco:" << endl;
+        for (int i = 0; i < diskSizeBlocks; ++i) {
+            cout << "[" << i << "] ░" << endl;
         }
+
+        while (true){
+            cout << "Escolha o tipo de alocação:\n1. Contígua\n2. Encadeada\n3. Indexada\n4. Extents\n5. Mista (método escolhido por arquivo)\n";
+            cin >> tipoAlocacao;
+    
+            if (cin.fail()) { // entrada não numérica
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << "Entrada inválida! Digite um número entre 1 e 5.\n";
+                continue;
+            }
+
+            if (tipoAlocacao < 1 || tipoAlocacao > 5) {
+                cout << "Opção inválida! Digite 1, 2, 3, 4 ou 5.\n";
+                continue;
+            }
+                break;
+            }
+
+        char respostaAtrasada;
+        cout << "Usar alocação atrasada (write-back)? (s/n): ";
+        cin >> respostaAtrasada;
+        alocacaoAtrasada.ativa = (respostaAtrasada == 's' || respostaAtrasada == 'S');
+    }
     
+    reconstruirMetricas(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+
     while (true) {
+        apresentarQuadroPendente();
         cout << "\nAgora, selecione uma das opções:\n";
         cout << "1. Criar arquivo\n";
         cout << "2. Deletar arquivo\n";
@@ -1185,20 +7545,47 @@ int main() {
         cout << "5. Estender arquivo\n";
         cout << "6. Simular leitura do arquivo (sequencial vs aleatória)\n";
         cout << "7. Encerrar o programa\n";
+        if (alocacaoAtrasada.ativa) {
+            cout << "8. Sincronizar buffers (alocação atrasada)\n";
+        }
+        cout << "9. Configurar cache de blocos (" << nomeDaPolitica(cacheBlocos.politica) << ")\n";
+        cout << "10. Salvar checkpoint da imagem do disco\n";
+        cout << "11. Carregar imagem do disco\n";
+        cout << "12. Journal de metadados (" << nomeDoModoJournal(journal.modo) << ")\n";
+        cout << "13. Verificar consistência do disco (fsck)\n";
+        cout << "14. Snapshots do volume (" << snapshots.size() << " salvos)\n";
+        cout << "15. Comparar todas as estratégias com a mesma carga (experimento paralelo)\n";
+        cout << "16. Benchmark do núcleo concorrente (1 a N threads)\n";
+        cout << "17. Leitura assíncrona: vazão por profundidade da fila de E/S\n";
+        cout << "18. Clientes simulados disputando o disco (tempo virtual)\n";
+        cout << "19. Exportar métricas (Prometheus/CSV)\n";
+        cout << "20. Rastreamento de tempo (trace-event JSON, "
+             << (rastreamento.ativo.load(memory_order_relaxed) ? "ativo" : "desativado") << ")\n";
+        cout << "21. Envelhecer um volume vazio e salvar a imagem (aging)\n";
+        cout << "22. Mapa compacto do disco (trechos e zoom por intervalo)\n";
+        cout << "23. Redesenho incremental do disco (" << (painelDisco.ativo ? "ativo" : "desativado") << ")\n";
+        cout << "24. Exportar o layout do disco em colunas (análise offline)\n";
         int opcao;
         cin >> opcao;
 
         switch (opcao) {
             case 1:
-                if (tipoAlocacao == 1) {
+                if (alocacaoAtrasada.ativa) {
+                    criarArquivoAtrasado(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                         fileID, tipoAlocacao);
+                } else if (tipoAlocacao == 1) {
                     criarArquivoContiguo(disk, filesContiguous, fileID);
                 } else if (tipoAlocacao == 2) {
                     criarArquivoEncadeado(disk, filesEncadeados, fileID);
                 } else if (tipoAlocacao == 3) {
                     criarArquivoIndexado(disk, filesIndexados, fileID);
+                } else if (tipoAlocacao == 4) {
+                    criarArquivoExtents(disk, filesExtents, fileID);
+                } else if (tipoAlocacao == 5) {
+                    criarArquivoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID);
                 } break;
             case 2:
-                deleteArquivo(disk, filesContiguous, filesEncadeados, filesIndexados);
+                deleteArquivo(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
                 break;
             case 3:
                 if (tipoAlocacao == 1) {
@@ -1207,6 +7594,10 @@ int main() {
                     displayEncadeado(disk, filesEncadeados);
                 } else if (tipoAlocacao == 3) {
                     displayIndexado(disk, filesIndexados);
+                } else if (tipoAlocacao == 4) {
+                    displayExtents(disk, filesExtents);
+                } else if (tipoAlocacao == 5) {
+                    displayMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
                 } break;
             case 4:
                 if (tipoAlocacao == 1) {
@@ -1215,28 +7606,148 @@ int main() {
                     displayDiretorioEncadeado(filesEncadeados);
                 } else if (tipoAlocacao == 3) {
                     displayDiretorioIndexado(filesIndexados);
-                } break;
+                } else if (tipoAlocacao == 4) {
+                    displayDiretorioExtents(filesExtents);
+                } else if (tipoAlocacao == 5) {
+                    displayDiretorioContiguo(filesContiguous);
+                    displayDiretorioEncadeado(filesEncadeados);
+                    displayDiretorioIndexado(filesIndexados);
+                    displayDiretorioExtents(filesExtents);
+                    displayResumoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+                }
+                if (alocacaoAtrasada.ativa) {
+                    displayEstatisticasAtrasada();
+                }
+                displayMetricasVolume();
+                displayTotaisReadahead();
+                displayEstatisticasJournal(journal);
+                break;
             case 5:
-                if (tipoAlocacao == 1) {
+                if (alocacaoAtrasada.ativa) {
+                    estenderArquivoAtrasado(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                            fileID);
+                } else if (tipoAlocacao == 1) {
                     estenderArquivoContiguo(disk, filesContiguous,   tabelaDiretorio);
                 } else if (tipoAlocacao == 2) {
                     estenderArquivoEncadeado(disk, filesEncadeados,   tabelaDiretorio);
                 } else if (tipoAlocacao == 3) {
                     estenderArquivoIndexado(disk, filesIndexados,   tabelaDiretorio);
+                } else if (tipoAlocacao == 4) {
+                    estenderArquivoExtents(disk, filesExtents,   tabelaDiretorio);
+                } else if (tipoAlocacao == 5) {
+                    estenderArquivoMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
                 } break;
             case 6: 
+                // a leitura simula o dispositivo: os dados precisam estar em blocos
+                descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                   fileID, "leitura");
                 if (tipoAlocacao == 1) {
                     simularLeituraContiguo(filesContiguous );
                 } else if (tipoAlocacao == 2) {
                     simularLeituraEncadeado(disk, filesEncadeados );
                 } else if (tipoAlocacao == 3) {
                     simularLeituraIndexado(filesIndexados);
+                } else if (tipoAlocacao == 4) {
+                    simularLeituraExtents(filesExtents);
+                } else if (tipoAlocacao == 5) {
+                    simularLeituraMisto(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
                 } break;
             case 7:
+                // desmontagem limpa: confirma o grupo pendente e esvazia o log
+                commitGrupo(journal);
+                checkpointJournal(journal);
+                encerrarPainel();
                 cout << "Encerrando o programa..." << endl;
                 return 0;
+            case 10:
+                // buffers pendentes não fazem parte da imagem: sincroniza antes do checkpoint
+                descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                   fileID, "checkpoint");
+                commitGrupo(journal);
+                salvarImagemDisco(promptCaminhoImagem(), disk, filesContiguous, filesEncadeados, filesIndexados,
+                                  filesExtents, tipoAlocacao, fileID);
+                break;
+            case 11:
+                if (carregarImagemDisco(promptCaminhoImagem(), disk, filesContiguous, filesEncadeados,
+                                        filesIndexados, filesExtents, tipoAlocacao, fileID) &&
+                    journal.modo != JOURNAL_DESATIVADO) {
+                    iniciarJournal(journal, journal.modo, capturarEstado(disk, filesContiguous, filesEncadeados,
+                                                                         filesIndexados, filesExtents));
+                }
+                break;
+            case 12:
+                configurarJournalMenu(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+                break;
+            case 13:
+                verificarConsistenciaMenu(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+                break;
+            case 14:
+                snapshotsMenu(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, tipoAlocacao,
+                              fileID);
+                break;
+            case 15:
+                executarExperimentosMenu(disk);
+                break;
+            case 16:
+                benchmarkConcorrenteMenu();
+                break;
+            case 17:
+                descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                   fileID, "leitura");
+                simularLeituraAssincronaMenu(filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+                break;
+            case 18:
+                clientesSimuladosMenu(tipoAlocacao);
+                break;
+            case 19:
+                exportacaoMetricasMenu();
+                break;
+            case 20:
+                rastreamentoMenu();
+                break;
+            case 21:
+                envelhecimentoMenu(disk, tipoAlocacao);
+                break;
+            case 22:
+                mapaCompactoMenu(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+                break;
+            case 23:
+                painelIncrementalMenu();
+                break;
+            case 24:
+                // buffers pendentes ainda não têm blocos: sincroniza para o layout refletir todos os arquivos
+                descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                   fileID, "exportação do layout");
+                exportacaoLayoutMenu(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents);
+                break;
+            case 8:
+                if (alocacaoAtrasada.ativa) {
+                    descarregarBuffers(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents,
+                                       fileID, "sincronização");
+                    displayEstatisticasAtrasada();
+                    alocacaoAtrasada.operacoesDesdeFlush = 0;
+                    break;
+                }
+                [[fallthrough]];
+            case 9:
+                if (opcao == 9) {
+                    configurarCacheMenu();
+                    break;
+                }
+                [[fallthrough]];
             default:
-                cout << "Opção inválida! Digite um número entre 1 e 7.\n" << endl;
+                cout << "Opção inválida! Digite um número entre 1 e 24.\n" << endl;
+        }
+
+        // as demais opções que mexem no disco não marcam blocos: o painel é redesenhado inteiro na próxima vez
+        if (opcao == 2 || opcao == 6 || opcao == 8 || (opcao >= 10 && opcao <= 14) || opcao == 24 ||
+            alocacaoAtrasada.ativa) {
+            invalidarPainel();
+        }
+        tickAlocacaoAtrasada(disk, filesContiguous, filesEncadeados, filesIndexados, filesExtents, fileID);
+        if (journal.modo != JOURNAL_DESATIVADO) {
+            registrarTransacao(journal, capturarEstado(disk, filesContiguous, filesEncadeados, filesIndexados,
+                                                       filesExtents));
         }
     }   
 }
\ No newline at end of file